@@ -0,0 +1,352 @@
+// Microbenchmarks das primitivas quentes dos drivers.
+// No alvo mede ciclos com o SysTick; no host (BENCH_HOST) mede nanossegundos com o relógio monotônico
+// sobre a HAL simulada de bench/host. Cada amostra cronometra um lote de chamadas e guarda o tempo por chamada;
+// resultados por chamada, em uma linha estável:
+//   BENCH <nome> <unidade> <média> <mínimo> <máximo> <iterações> <mediana>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "headers/ssd1306.h"
+#include "headers/oled_local.h"
+#include "headers/phase_local.h"
+#include "headers/oled_screens.h"
+#include "headers/alert_msg.h"
+#include "headers/hot_path.h"
+#include "bench_limits.h"
+
+// Os drivers abaixo são incluídos diretamente para alcançar as funções static
+#include "lib/leds.c"
+#include "lib/interrupt.c"
+
+#define PIN_I2C_SDA 14
+#define PIN_I2C_SCL 15
+#define PIN_I2C0_SDA 0   // Segundo display, em outro barramento
+#define PIN_I2C0_SCL 1
+#define PIN_LEDS 7
+#define PIN_IRQ_PROBE 5  // Botão A: a borda de descida é forçada por software para medir a entrada na ISR
+#define BENCH_MAX_RESULTS 16
+#define BENCH_MAX_SAMPLES 1024  // Amostras por resultado (o lote cresce para caber)
+
+#ifndef BENCH_HOST
+#define BENCH_HOST 0
+#endif
+
+#if BENCH_HOST
+#include <time.h>
+#define BENCH_UNIT "ns"
+static inline uint32_t bench_Now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
+static inline uint32_t bench_Elapsed(uint32_t start, uint32_t end) {
+  return end - start;
+}
+static inline void bench_Flush_Xip() {}
+#define BENCH_BATCH 64  // No host uma chamada isolada dura dezenas de ns, abaixo do ruído do relógio
+#else
+#include "hardware/structs/systick.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "hardware/structs/io_bank0.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#define BENCH_UNIT "cycles"
+#define BENCH_BATCH 1   // O SysTick conta ciclos: no alvo cada chamada pode ser medida sozinha
+static inline uint32_t bench_Now() {
+  return systick_hw->cvr;
+}
+static inline uint32_t bench_Elapsed(uint32_t start, uint32_t end) {
+  return (start - end) & 0x00FFFFFF;  // O SysTick é um contador decrescente de 24 bits
+}
+// Esvazia o cache da flash para medir o pior caso (código e tabelas vindo da flash)
+static inline void bench_Flush_Xip() {
+  xip_ctrl_hw->flush = 1;
+  (void)xip_ctrl_hw->flush;  // A leitura espera o esvaziamento terminar
+}
+#endif
+
+typedef struct {
+  const char *name;
+  uint32_t avg, min, max, iters, median;
+  uint32_t limit;  // Limite na unidade do resultado (0 = sem limite)
+  const char *unit;  // NULL = BENCH_UNIT
+} BenchResult;
+
+static int bench_Check();
+
+static BenchResult RESULTS[BENCH_MAX_RESULTS];
+static int RESULT_COUNT = 0;
+static uint32_t OVERHEAD = 0;  // Custo da própria medição, descontado de cada amostra
+
+static ssd1306_t bench_ssd;
+static oled_t bench_oled;
+static uint8_t bench_colors[9][3] = {{0,10,0},{0,10,0},{0,10,0},{0,10,0},{0,10,0},{0,10,0},{0,10,0},{0,10,0},{0,10,0}};
+static uint8_t bench_leds[9] = {6,7,8,11,12,13,16,17,18};
+static volatile int bench_sink;
+
+static void bench_Pixel(uint32_t i) { ssd1306_pixel(&bench_ssd, i & 127, (i >> 7) & 63, i & 1); }
+static void bench_Fill(uint32_t i) { ssd1306_fill(&bench_ssd, i & 1); }
+static void bench_Write_String(uint32_t i) { (void)i; oled_Write_String(&bench_oled, "Pode Atravessar", 2, 27); }
+static void bench_Rgb_To_Grb(uint32_t i) { (void)i; Leds_rgb_to_grb(colors); }
+static void bench_Map_Leds(uint32_t i) { (void)i; Leds_Map_leds_ON(bench_leds, bench_colors, 9, true); }
+static void bench_Debounce(uint32_t i) { itr_Button_Callback(5, GPIO_IRQ_EDGE_FALL); (void)i; }
+static void bench_Noop_Callback(uint gpio, uint32_t events) { bench_sink = gpio + events; }
+static void bench_Phase_Index(uint32_t i) {
+  static const int timers[3] = {5000, 3000, 500};
+  int phase = phase_Next(i % 3);
+  bench_sink = phase_Leds_Index(phase, i & 4) + phase_Alert_Index(phase, i & 4) + phase_Duration(phase, i & 4, timers);
+}
+
+static uint32_t SAMPLES[BENCH_MAX_SAMPLES];
+
+static int bench_Compare(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return x < y ? -1 : x > y;
+}
+// Mediana das primeiras count amostras (reordena SAMPLES)
+static uint32_t bench_Median(uint32_t count) {
+  qsort(SAMPLES, count, sizeof(SAMPLES[0]), bench_Compare);
+  return SAMPLES[count / 2];
+}
+// Custo da própria medição (duas leituras do relógio), o menor de várias tentativas
+static uint32_t bench_Overhead() {
+  uint32_t overhead = UINT32_MAX;
+  for (int i = 0; i < 1000; i++) {
+    uint32_t start = bench_Now();
+    uint32_t elapsed = bench_Elapsed(start, bench_Now());
+    if (elapsed < overhead) overhead = elapsed;
+  }
+  return overhead;
+}
+// Executa fn cerca de iters vezes em amostras de BENCH_BATCH chamadas (o lote cresce para caber em
+// BENCH_MAX_SAMPLES); cold esvazia o cache XIP antes de cada chamada e, no alvo, mede uma chamada por amostra
+static BenchResult bench_Measure(const char *name, void (*fn)(uint32_t), uint32_t iters, uint32_t limit, bool cold) {
+  BenchResult r = {name, 0, UINT32_MAX, 0, 0, 0, limit, NULL};
+  uint32_t batch = BENCH_BATCH;
+  if (!(cold && !BENCH_HOST) && iters / batch > BENCH_MAX_SAMPLES) batch = (iters + BENCH_MAX_SAMPLES - 1) / BENCH_MAX_SAMPLES;
+  uint32_t samples = iters / batch;
+  if (samples > BENCH_MAX_SAMPLES) samples = BENCH_MAX_SAMPLES;
+  if (samples == 0) samples = 1;
+  uint64_t total = 0;
+  uint32_t call = 0;
+  for (uint32_t s = 0; s < samples; s++) {
+    if (cold) bench_Flush_Xip();
+    uint32_t start = bench_Now();
+    for (uint32_t b = 0; b < batch; b++) fn(call + b);
+    uint32_t elapsed = bench_Elapsed(start, bench_Now());
+    call += batch;
+    elapsed = (elapsed > OVERHEAD ? elapsed - OVERHEAD : 0) / batch;
+    SAMPLES[s] = elapsed;
+    total += elapsed;
+    if (elapsed < r.min) r.min = elapsed;
+    if (elapsed > r.max) r.max = elapsed;
+  }
+  r.median = bench_Median(samples);
+  r.avg = (uint32_t)(total / samples);
+  r.iters = call;
+  return r;
+}
+
+static void bench_Report(BenchResult r) {
+  printf("BENCH %s %s %lu %lu %lu %lu %lu\n", r.name, r.unit ? r.unit : BENCH_UNIT, (unsigned long)r.avg,
+         (unsigned long)r.min, (unsigned long)r.max, (unsigned long)r.iters, (unsigned long)r.median);
+  if (RESULT_COUNT < BENCH_MAX_RESULTS) RESULTS[RESULT_COUNT++] = r;
+}
+static void bench_Run(const char *name, void (*fn)(uint32_t), uint32_t iters, uint32_t limit, bool cold) {
+  bench_Report(bench_Measure(name, fn, iters, limit, cold));
+}
+
+#if !BENCH_HOST
+static volatile uint32_t IRQ_ENTRY;
+static volatile bool IRQ_DONE;
+
+// Callback da interrupção forçada, chamado pelo caminho real (tratador de IRQ e debounce): marca o tempo de entrada
+static void HOT_FUNC(bench_Irq_Probe)(uint gpio, uint32_t events) {
+  IRQ_ENTRY = bench_Now();
+  hw_clear_bits(&io_bank0_hw->proc0_irq_ctrl.intf[gpio / 8], events << (4 * (gpio % 8)));
+  IRQ_DONE = true;
+}
+// Latência de entrada na ISR (do disparo até o callback) com o cache XIP frio; max - min é o jitter
+static BenchResult bench_Isr_Latency(uint32_t iters) {
+  BenchResult r = {"isr_entry_cold", 0, UINT32_MAX, 0, iters, 0, BENCH_LIMIT_ISR_ENTRY_COLD, NULL};
+  uint64_t total = 0;
+  uint32_t wait_time = WAIT_TIME;
+  WAIT_TIME = 0;  // Sem debounce, toda borda forçada chega ao callback
+  itr_SetCallbackFunction(bench_Irq_Probe);
+  itr_Interruption(PIN_IRQ_PROBE);
+  for (uint32_t i = 0; i < iters; i++) {
+    IRQ_DONE = false;
+    bench_Flush_Xip();
+    uint32_t start = bench_Now();
+    hw_set_bits(&io_bank0_hw->proc0_irq_ctrl.intf[PIN_IRQ_PROBE / 8], GPIO_IRQ_EDGE_FALL << (4 * (PIN_IRQ_PROBE % 8)));
+    while (!IRQ_DONE) tight_loop_contents();
+    uint32_t elapsed = bench_Elapsed(start, IRQ_ENTRY);
+    if (i < BENCH_MAX_SAMPLES) SAMPLES[i] = elapsed;
+    total += elapsed;
+    if (elapsed < r.min) r.min = elapsed;
+    if (elapsed > r.max) r.max = elapsed;
+  }
+  gpio_set_irq_enabled(PIN_IRQ_PROBE, GPIO_IRQ_EDGE_FALL, false);
+  WAIT_TIME = wait_time;
+  itr_SetCallbackFunction(bench_Noop_Callback);
+  r.avg = (uint32_t)(total / iters);
+  r.median = bench_Median(iters < BENCH_MAX_SAMPLES ? iters : BENCH_MAX_SAMPLES);
+  return r;
+}
+
+// Atualização completa de displays 128x64 pelo gerenciador real do barramento (DMA + tarefa por barramento).
+// Roda numa tarefa, com o FreeRTOS usando o SysTick, então é medida em us. Retorna false se algum envio falhou.
+static bool bench_Refresh(BenchResult *r, oled_t *const oleds[], int count) {
+  uint64_t total = 0;
+  *r = (BenchResult){r->name, 0, UINT32_MAX, 0, r->iters, 0, r->limit, "us"};
+  for (uint32_t i = 0; i < r->iters; i++) {
+    uint32_t elapsed = oled_Update_All(oleds, count);
+    for (int j = 0; j < count; j++) {
+      if (oled_Update_Wait(oleds[j], 0) < 0) return false;
+    }
+    if (i < BENCH_MAX_SAMPLES) SAMPLES[i] = elapsed;
+    total += elapsed;
+    if (elapsed < r->min) r->min = elapsed;
+    if (elapsed > r->max) r->max = elapsed;
+  }
+  r->avg = (uint32_t)(total / r->iters);
+  r->median = bench_Median(r->iters < BENCH_MAX_SAMPLES ? r->iters : BENCH_MAX_SAMPLES);
+  return true;
+}
+// Um display sozinho e dois em barramentos diferentes: com envios de fato paralelos, x2 fica perto de x1.
+// Precisa de um segundo SSD1306 em 0x3C no i2c0 (GPIO 0/1); sem ele o resultado x2 é pulado.
+static void bench_Refresh_Task(void *param) {
+  static oled_t second;
+  oled_t *const oleds[2] = {&bench_oled, &second};
+  BenchResult r = {"oled_refresh_x1", 0, 0, 0, 16, 0, 0, "us"};
+  (void)param;
+  oled_Init(&second, "bench oled i2c0", i2c0, PIN_I2C0_SDA, PIN_I2C0_SCL, 0x3C, 128, 64, true);
+  if (bench_Refresh(&r, oleds, 1)) bench_Report(r);
+  else printf("BENCH_SKIP oled_refresh_x1 sem display no i2c1\n");
+  r = (BenchResult){"oled_refresh_x2", 0, 0, 0, 16, 0, BENCH_LIMIT_OLED_REFRESH_X2, "us"};
+  if (bench_Refresh(&r, oleds, 2)) bench_Report(r);
+  else printf("BENCH_SKIP oled_refresh_x2 sem display no i2c0\n");
+  bench_Check();
+  while (true) vTaskDelay(portMAX_DELAY);
+}
+#endif
+
+#if BENCH_HOST
+// Lê os limites de um arquivo com a saída de uma execução anterior: mediana do baseline mais a tolerância
+// percentual e um piso absoluto, pois alguns ns de ruído já seriam dezenas de por cento em primitivas curtas
+static void bench_Load_Baseline(const char *path, uint32_t threshold_pct) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "bench: baseline %s nao encontrado\n", path);
+    return;
+  }
+  char line[160], name[64], unit[16];
+  unsigned long avg, min, max, iters, median;
+  while (fgets(line, sizeof(line), f)) {
+    if (strncmp(line, "BENCH ", 6) != 0 ||
+        sscanf(line + 6, "%63s %15s %lu %lu %lu %lu %lu", name, unit, &avg, &min, &max, &iters, &median) != 7) continue;
+    for (int i = 0; i < RESULT_COUNT; i++) {
+      if (strcmp(RESULTS[i].name, name) == 0) RESULTS[i].limit = median + median * threshold_pct / 100 + BENCH_HOST_FLOOR_NS;
+    }
+  }
+  fclose(f);
+}
+#endif
+
+// Confere se cada mensagem de alerta do firmware tem tela pré-renderizada na posição usada e se a imagem é igual
+// ao que oled_Write_String desenha; sem isso oled_Show_Prerendered cairia em silêncio no desenho por pixel
+static int bench_Check_Screens() {
+  static const char *const alerts[ALERT_MSG_COUNT] = ALERT_MSG_LIST;
+  int failures = 0;
+  for (int i = 0; i < ALERT_MSG_COUNT; i++) {
+    const oled_screen_t *screen = NULL;
+    for (size_t s = 0; s < OLED_SCREENS_COUNT; s++) {
+      if (OLED_SCREENS[s].x == ALERT_MSG_X && OLED_SCREENS[s].y == ALERT_MSG_Y && !strcmp(OLED_SCREENS[s].text, alerts[i]))
+        screen = &OLED_SCREENS[s];
+    }
+    oled_Clear(&bench_oled);
+    oled_Write_String(&bench_oled, alerts[i], ALERT_MSG_X, ALERT_MSG_Y);
+    bool same = screen != NULL;
+    if (same && screen->rle) {  // Expande os pares (quantidade, valor) e compara com o buffer desenhado
+      size_t n = 1;
+      for (size_t j = 0; same && j + 1 < screen->len; j += 2) {
+        for (uint8_t k = 0; same && k < screen->data[j]; k++, n++) same = n < bench_oled.bufsize && bench_oled.ram_buffer[n] == screen->data[j + 1];
+      }
+      same = same && n == bench_oled.bufsize;
+    } else if (same) {
+      same = screen->len == bench_oled.bufsize && !memcmp(screen->data + 1, bench_oled.ram_buffer + 1, screen->len - 1);
+    }
+    if (!same) {
+      printf("BENCH_SCREEN_MISMATCH \"%s\" %s\n", alerts[i], screen ? "imagem diferente" : "sem tela");
+      failures++;
+    }
+  }
+  return failures;
+}
+
+// Compara os resultados com os limites; retorna a quantidade de regressões.
+// No alvo os ciclos são determinísticos e vale a média; no host vale a mediana, que ignora preempções do SO.
+static int bench_Check() {
+  int failures = bench_Check_Screens();
+  for (int i = 0; i < RESULT_COUNT; i++) {
+    uint32_t value = BENCH_HOST ? RESULTS[i].median : RESULTS[i].avg;
+    if (RESULTS[i].limit && value > RESULTS[i].limit) {
+      printf("BENCH_REGRESSION %s %lu > %lu\n", RESULTS[i].name, (unsigned long)value, (unsigned long)RESULTS[i].limit);
+      failures++;
+    }
+  }
+  printf("BENCH_RESULT %s\n", failures ? "FAIL" : "PASS");
+  return failures;
+}
+
+int main(int argc, char **argv) {
+  stdio_init_all();
+#if BENCH_HOST
+  const char *baseline = NULL;
+  uint32_t threshold = BENCH_DEFAULT_THRESHOLD_PCT;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--baseline") && i + 1 < argc) baseline = argv[++i];
+    else if (!strcmp(argv[i], "--threshold") && i + 1 < argc) threshold = atoi(argv[++i]);
+  }
+#else
+  (void)argc; (void)argv;
+  sleep_ms(3000);  // Tempo para o host abrir a serial USB
+  systick_hw->rvr = 0x00FFFFFF;
+  systick_hw->cvr = 0;
+  systick_hw->csr = 0x5;  // Habilita o SysTick com o clock do processador
+#endif
+
+  ssd1306_init(&bench_ssd, 128, 64, false, 0x3C, i2c1, "bench ssd1306");
+  oled_Init(&bench_oled, "bench oled", i2c1, PIN_I2C_SDA, PIN_I2C_SCL, 0x3C, 128, 64, true);
+  Leds_init(PIN_LEDS, 25, true);
+  itr_SetCallbackFunction(bench_Noop_Callback);
+
+  OVERHEAD = bench_Overhead();
+  bench_Run("ssd1306_pixel", bench_Pixel, 8192, BENCH_LIMIT_SSD1306_PIXEL, false);
+  bench_Run("ssd1306_fill", bench_Fill, 64, BENCH_LIMIT_SSD1306_FILL, false);
+  bench_Run("oled_Write_String", bench_Write_String, 256, BENCH_LIMIT_OLED_WRITE_STRING, false);
+  bench_Run("Leds_rgb_to_grb", bench_Rgb_To_Grb, 1024, BENCH_LIMIT_LEDS_RGB_TO_GRB, false);
+  bench_Run("Leds_Map_leds_ON", bench_Map_Leds, 128, BENCH_LIMIT_LEDS_MAP_LEDS_ON, false);
+  bench_Run("itr_Button_Callback", bench_Debounce, 4096, BENCH_LIMIT_ITR_DEBOUNCE, false);
+  bench_Run("phase_index", bench_Phase_Index, 4096, BENCH_LIMIT_PHASE_INDEX, false);
+  // Pior caso com o cache XIP frio: compara builds com e sem SEMAFORO_RAM_HOT_PATH
+  bench_Run("ssd1306_pixel_cold", bench_Pixel, 1024, 0, true);
+  bench_Run("Leds_rgb_to_grb_cold", bench_Rgb_To_Grb, 256, 0, true);
+  bench_Run("itr_Button_Callback_cold", bench_Debounce, 1024, 0, true);
+#if !BENCH_HOST
+  bench_Report(bench_Isr_Latency(256));
+#endif
+  printf("BENCH_CONFIG ram_hot_path=%d\n", SEMAFORO_RAM_HOT_PATH);
+
+#if BENCH_HOST
+  for (int i = 0; i < RESULT_COUNT; i++) RESULTS[i].limit = 0;  // Os limites do alvo não valem no host
+  if (baseline) bench_Load_Baseline(baseline, threshold);
+  return bench_Check() ? 1 : 0;
+#else
+  // As medições com FreeRTOS vêm por último: o escalonador toma o SysTick
+  xTaskCreate(bench_Refresh_Task, "bench Refresh", 2 * configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL);
+  vTaskStartScheduler();
+  while (true) tight_loop_contents();
+#endif
+}
@@ -0,0 +1,22 @@
+#ifndef BENCH_LIMITS_H
+#define BENCH_LIMITS_H
+
+// Limites de regressão no alvo (RP2040 a 125 MHz), em ciclos médios por chamada (em us nos resultados marcados).
+// Uma primitiva acima do limite faz o benchmark terminar com "BENCH_RESULT FAIL".
+// No host os limites vêm da mediana de uma execução anterior (--baseline) mais a tolerância (--threshold)
+// e o piso BENCH_HOST_FLOOR_NS.
+#define BENCH_LIMIT_SSD1306_PIXEL      60
+#define BENCH_LIMIT_SSD1306_FILL       600000
+#define BENCH_LIMIT_OLED_WRITE_STRING  60000
+#define BENCH_LIMIT_LEDS_RGB_TO_GRB    1500
+#define BENCH_LIMIT_LEDS_MAP_LEDS_ON   120000  // Inclui o envio dos 25 LEDs pela PIO (~750 us)
+#define BENCH_LIMIT_ITR_DEBOUNCE       400
+#define BENCH_LIMIT_PHASE_INDEX        120
+#define BENCH_LIMIT_OLED_REFRESH_X2    32000   // Em us: dois quadros de 1 KB em barramentos diferentes (~24 ms se
+                                               // paralelos; ~47 ms se o envio fosse serializado)
+#define BENCH_LIMIT_ISR_ENTRY_COLD     2000    // Do disparo da interrupção GPIO ao callback, cache XIP frio
+
+#define BENCH_DEFAULT_THRESHOLD_PCT    25      // Tolerância padrão em relação ao baseline no host
+#define BENCH_HOST_FLOOR_NS            10      // Folga absoluta somada ao limite no host (ruído do relógio)
+
+#endif
@@ -0,0 +1,149 @@
+// Teste de host do console sob enxurrada de comandos.
+// Uma thread faz o papel da tarefa do console e recebe linhas sem parar (conjuntos completos de parâmetros
+// intercalados com "s", comandos inválidos e linhas longas demais); a thread principal faz o papel da tarefa RGB,
+// troca de fase em prazos absolutos e só então chama console_Take_Pending.
+// Verifica que cada conjunto entregue é inteiro (nunca mistura dois conjuntos) e que o desvio das trocas de fase
+// (phase_Get_Stats após cada troca) com a enxurrada não passa do desvio sem ela mais CONSOLE_FLOOD_TOLERANCE_US.
+// Compara o percentil 90 e não o máximo: o host tem pausas de alguns ms que não dependem do teste.
+//
+// Saída: CONSOLE_FLOOD <medidas> e CONSOLE_FLOOD_RESULT PASS|FAIL (código de saída 1 em caso de falha)
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "lib/console.c"
+
+#define PHASE_MS 20                        // Duração de cada fase simulada
+#define PHASES 50                          // Trocas por rodada
+#define CONSOLE_FLOOD_TOLERANCE_US 2000    // Folga para o ruído do escalonador do host
+#define FLOOD_SETS 200                     // Conjuntos distintos no roteiro da enxurrada
+#define PERCENTILE 90
+
+static pthread_mutex_t CRITICAL = PTHREAD_MUTEX_INITIALIZER;
+static char SCRIPT[FLOOD_SETS * 256];
+static size_t SCRIPT_LEN = 0, SCRIPT_POS = 0;
+static volatile bool FLOODING = false;
+static volatile bool RUNNING = true;
+static unsigned long CHARS = 0;
+
+// FreeRTOS e stdio simulados
+BaseType_t xTaskCreate(void (*task)(void *), const char *name, uint32_t stack, void *param, uint32_t priority,
+                       TaskHandle_t *handle) {
+  (void)task; (void)name; (void)stack; (void)param; (void)priority; (void)handle;
+  return 1;
+}
+void vTaskDelay(TickType_t ticks) {
+  struct timespec ts = {0, (long)ticks * 1000000L};
+  nanosleep(&ts, NULL);
+}
+void taskENTER_CRITICAL(void) { pthread_mutex_lock(&CRITICAL); }
+void taskEXIT_CRITICAL(void) { pthread_mutex_unlock(&CRITICAL); }
+bool stdio_usb_connected(void) { return false; }
+int getchar_timeout_us(uint32_t timeout_us) {
+  (void)timeout_us;
+  if (!FLOODING) return PICO_ERROR_TIMEOUT;
+  int c = SCRIPT[SCRIPT_POS++];
+  if (SCRIPT_POS == SCRIPT_LEN) SCRIPT_POS = 0;
+  CHARS++;
+  return c;
+}
+// Módulos que o console só consulta no comando "s"/"i"/"j"
+latch_stats_t latch_Get_Stats() { return (latch_stats_t){0}; }
+void latch_Reset_Stats() {}
+bool i2c_bus_Get_Stats(int client, const char **name, i2c_bus_stats_t *stats) {
+  (void)client; (void)name; (void)stats;
+  return false;
+}
+bool wdt_Get_Recovery(wdt_recovery_t *recovery, const char **hung_name) {
+  (void)recovery; (void)hung_name;
+  return false;
+}
+
+// Roteiro: o conjunto k tem todos os campos iguais a k, então um conjunto misturado é detectável
+static void flood_Script() {
+  for (int s = 0; s < FLOOD_SETS; s++) {
+    int k = 50 + s % 200;
+    char *p = SCRIPT + SCRIPT_LEN;
+    p += sprintf(p, "t %d %d %d\n", k, k, k);
+    for (int i = 0; i < 4; i++) p += sprintf(p, "c %d %d %d %d\ns\n", i, k, k, k);
+    for (int i = 0; i < 4; i++) p += sprintf(p, "b %d %d %d %d\n", i, k, k, k);
+    if (s % 3 == 0) p += sprintf(p, "x\nt 1 2\n%060d\n", 0);  // Comandos inválidos e linha longa demais
+    p += sprintf(p, "a\n");
+    SCRIPT_LEN = p - SCRIPT;
+  }
+}
+// Valor comum a todos os campos do conjunto, ou -1 se o conjunto está misturado
+static int flood_Set_Value(const console_params_t *params) {
+  int k = params->timers[0];
+  for (int i = 0; i < 3; i++) if (params->timers[i] != k) return -1;
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      if (params->colors[i][j] != k || params->beeps[i][j] != k) return -1;
+    }
+  }
+  return k;
+}
+static void *flood_Console_Thread(void *arg) {
+  (void)arg;
+  while (RUNNING) vTaskDelay(pdMS_TO_TICKS(console_Poll() ? 1 : CONSOLE_PERIOD_MS));
+  return NULL;
+}
+static int flood_Compare(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return x < y ? -1 : x > y;
+}
+// Uma rodada de PHASES trocas em prazos absolutos; retorna o percentil do desvio e conta conjuntos inteiros e
+// misturados
+static uint32_t flood_Run(bool flood, int *whole, int *mixed, phase_stats_t *stats) {
+  struct timespec deadline;
+  uint32_t deviations[PHASES];
+  FLOODING = flood;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  phase_Mark_Start(PHASE_MS);
+  phase_Reset_Stats();  // A primeira marca só define o início
+  for (int i = 0; i < PHASES; i++) {
+    deadline.tv_nsec += PHASE_MS * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000L;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+    console_params_t params;
+    if (console_Take_Pending(&params)) {  // Só na troca de fase, como Apply_Console_Params
+      if (flood_Set_Value(&params) < 0) (*mixed)++;
+      else (*whole)++;
+    }
+    phase_Mark_Start(PHASE_MS);
+    deviations[i] = phase_Get_Stats().last_us;
+  }
+  FLOODING = false;
+  *stats = phase_Get_Stats();
+  qsort(deviations, PHASES, sizeof(deviations[0]), flood_Compare);
+  return deviations[PHASES * PERCENTILE / 100];
+}
+
+int main() {
+  console_params_t initial;
+  memset(&initial, 0, sizeof(initial));
+  console_Init(&initial);
+  flood_Script();
+  pthread_t console;
+  pthread_create(&console, NULL, flood_Console_Thread, NULL);
+
+  int whole = 0, mixed = 0;
+  phase_stats_t quiet_stats, flood_stats;
+  uint32_t quiet = flood_Run(false, &whole, &mixed, &quiet_stats);
+  int quiet_sets = whole;
+  uint32_t flood = flood_Run(true, &whole, &mixed, &flood_stats);
+  RUNNING = false;
+  pthread_join(console, NULL);
+
+  // Sem enxurrada nada é entregue; com ela só conjuntos inteiros, e todas as trocas são medidas
+  bool pass = quiet_sets == 0 && whole > 0 && mixed == 0 && quiet_stats.count == PHASES && flood_stats.count == PHASES &&
+              flood <= quiet + CONSOLE_FLOOD_TOLERANCE_US;
+  printf("CONSOLE_FLOOD chars=%lu conjuntos=%d misturados=%d desvio_p%d quieto=%lu us enxurrada=%lu us "
+         "max quieto=%lu us enxurrada=%lu us\n", CHARS, whole, mixed, PERCENTILE, (unsigned long)quiet,
+         (unsigned long)flood, (unsigned long)quiet_stats.max_us, (unsigned long)flood_stats.max_us);
+  printf("CONSOLE_FLOOD_RESULT %s\n", pass ? "PASS" : "FAIL");
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+// Implementação da HAL simulada: periféricos não fazem nada, o tempo vem do relógio do host
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/structs/io_bank0.h"
+#include "ws2812.pio.h"
+
+i2c_inst_t i2c0_inst = {0}, i2c1_inst = {1};
+struct pio_inst pio0_inst = {0, {0}};
+io_bank0_hw_t io_bank0_stub = {0};
+const pio_program_t ws2812_program = {4};
+volatile uint32_t HAL_SINK;  // Evita que o compilador descarte as escritas simuladas
+
+absolute_time_t get_absolute_time(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+void sleep_us(uint64_t us) {
+  struct timespec ts = {us / 1000000u, (us % 1000000u) * 1000};
+  nanosleep(&ts, NULL);
+}
+void sleep_ms(uint32_t ms) { sleep_us((uint64_t)ms * 1000); }
+bool stdio_init_all(void) { return true; }
+
+void gpio_init(uint gpio) { (void)gpio; }
+void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+void gpio_put(uint gpio, bool value) { HAL_SINK = gpio + value; }
+void gpio_put_masked(uint32_t mask, uint32_t value) { HAL_SINK = mask & value; }
+bool gpio_get(uint gpio) { (void)gpio; return true; }
+void gpio_pull_up(uint gpio) { (void)gpio; }
+void gpio_set_function(uint gpio, int fn) { (void)gpio; (void)fn; }
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled) { (void)gpio; (void)events; (void)enabled; }
+void irq_set_exclusive_handler(uint num, void (*handler)(void)) { (void)num; (void)handler; }
+void irq_set_enabled(uint num, bool enabled) { (void)num; (void)enabled; }
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) { (void)i2c; return baudrate; }
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+  (void)i2c; (void)addr; (void)nostop;
+  HAL_SINK = src[len - 1];
+  return (int)len;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) { (void)pio; (void)program; return 0; }
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) { (void)pio; (void)sm; (void)enabled; }
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) { (void)pio; (void)sm; HAL_SINK = data; }
+void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin, float freq, bool rgbw) {
+  (void)pio; (void)sm; (void)offset; (void)pin; (void)freq; (void)rgbw;
+}
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { (void)pio; (void)is_tx; return sm; }
+
+int dma_claim_unused_channel(bool required) { (void)required; return 0; }
+dma_channel_config dma_channel_get_default_config(uint channel) { return (dma_channel_config){channel}; }
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) { c->ctrl |= size; }
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) { c->ctrl |= incr << 4; }
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) { c->ctrl |= incr << 5; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) { c->ctrl |= dreq << 15; }
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+  (void)channel; (void)config; (void)write_addr; (void)read_addr; (void)transfer_count; (void)trigger;
+}
+// O DMA simulado copia na hora para a FIFO, então nunca há envio pendente
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+  const volatile uint32_t *src = read_addr;
+  (void)channel;
+  for (uint32_t i = 0; i < transfer_count; i++) pio0_inst.txf[0] = src[i];
+}
+void dma_channel_wait_for_finish_blocking(uint channel) { (void)channel; }
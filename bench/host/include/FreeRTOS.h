@@ -0,0 +1,15 @@
+// FreeRTOS simulado para os testes de host: só tipos e macros; as funções ficam com cada teste
+#ifndef BENCH_HOST_FREERTOS_H
+#define BENCH_HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef void *TaskHandle_t;
+
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskIDLE_PRIORITY 0
+#define configMINIMAL_STACK_SIZE 256
+
+#endif
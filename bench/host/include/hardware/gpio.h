@@ -0,0 +1,23 @@
+#ifndef BENCH_HOST_GPIO_H
+#define BENCH_HOST_GPIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef unsigned int uint;
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+#define GPIO_IRQ_EDGE_FALL 0x4u
+enum { GPIO_FUNC_I2C = 3, GPIO_FUNC_PWM = 4, GPIO_FUNC_SIO = 5 };
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+void gpio_put_masked(uint32_t mask, uint32_t value);
+bool gpio_get(uint gpio);
+void gpio_pull_up(uint gpio);
+void gpio_set_function(uint gpio, int fn);
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled);
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef BENCH_HOST_I2C_H
+#define BENCH_HOST_I2C_H
+
+#include "pico/stdlib.h"
+
+typedef struct i2c_inst { int index; } i2c_inst_t;
+extern i2c_inst_t i2c0_inst, i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef BENCH_HOST_IRQ_H
+#define BENCH_HOST_IRQ_H
+
+#include "pico/stdlib.h"
+
+#define IO_IRQ_BANK0 13
+
+void irq_set_exclusive_handler(uint num, void (*handler)(void));
+void irq_set_enabled(uint num, bool enabled);
+
+#endif
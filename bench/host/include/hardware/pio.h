@@ -0,0 +1,16 @@
+#ifndef BENCH_HOST_PIO_H
+#define BENCH_HOST_PIO_H
+
+#include "pico/stdlib.h"
+
+typedef struct pio_inst { int index; uint32_t txf[4]; } *PIO;
+extern struct pio_inst pio0_inst;
+#define pio0 (&pio0_inst)
+typedef struct pio_program { int length; } pio_program_t;
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+
+#endif
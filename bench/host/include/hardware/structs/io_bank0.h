@@ -0,0 +1,16 @@
+#ifndef BENCH_HOST_IO_BANK0_H
+#define BENCH_HOST_IO_BANK0_H
+
+#include <stdint.h>
+
+typedef struct {
+  volatile uint32_t intr[4];
+  struct {
+    volatile uint32_t inte[4], intf[4], ints[4];
+  } proc0_irq_ctrl;
+} io_bank0_hw_t;
+
+extern io_bank0_hw_t io_bank0_stub;
+#define io_bank0_hw (&io_bank0_stub)
+
+#endif
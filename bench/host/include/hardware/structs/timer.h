@@ -0,0 +1,13 @@
+#ifndef BENCH_HOST_TIMER_H
+#define BENCH_HOST_TIMER_H
+
+#include "pico/stdlib.h"
+
+// Cada leitura de timer_hw->timerawl consulta o relógio do host
+typedef struct {
+  uint32_t timerawl;
+} timer_hw_t;
+
+#define timer_hw (&(timer_hw_t){time_us_32()})
+
+#endif
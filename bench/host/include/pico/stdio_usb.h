@@ -0,0 +1,8 @@
+#ifndef BENCH_HOST_STDIO_USB_H
+#define BENCH_HOST_STDIO_USB_H
+
+#include <stdbool.h>
+
+bool stdio_usb_connected(void);
+
+#endif
@@ -0,0 +1,26 @@
+// HAL simulada para medir os drivers no host (apenas o necessário para compilá-los)
+#ifndef BENCH_HOST_STDLIB_H
+#define BENCH_HOST_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "hardware/gpio.h"
+
+typedef uint64_t absolute_time_t;
+
+absolute_time_t get_absolute_time(void);
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline uint32_t time_us_32(void) { return (uint32_t)get_absolute_time(); }
+static inline uint64_t time_us_64(void) { return get_absolute_time(); }
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+#define PICO_ERROR_TIMEOUT (-1)
+#define tight_loop_contents() do {} while (0)
+#define __not_in_flash_func(f) f
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef BENCH_HOST_TASK_H
+#define BENCH_HOST_TASK_H
+
+#include "FreeRTOS.h"
+
+BaseType_t xTaskCreate(void (*task)(void *), const char *name, uint32_t stack, void *param, uint32_t priority,
+                       TaskHandle_t *handle);
+void vTaskDelay(TickType_t ticks);
+void taskENTER_CRITICAL(void);
+void taskEXIT_CRITICAL(void);
+
+#endif
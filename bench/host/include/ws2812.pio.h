@@ -0,0 +1,9 @@
+#ifndef BENCH_HOST_WS2812_PIO_H
+#define BENCH_HOST_WS2812_PIO_H
+
+#include "hardware/pio.h"
+
+extern const pio_program_t ws2812_program;
+void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin, float freq, bool rgbw);
+
+#endif
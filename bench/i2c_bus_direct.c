@@ -0,0 +1,37 @@
+// Versão direta do gerenciador de barramento para o benchmark (sem FreeRTOS):
+// cada transação é executada na hora por quem chama, medindo apenas o custo dos drivers.
+#include "headers/i2c_bus_local.h"
+
+static int CLIENT_COUNT = 0;
+
+void i2c_bus_Init(i2c_inst_t *i2c, uint pin_sda, uint pin_scl, uint baudrate) {
+  i2c_init(i2c, baudrate);
+  gpio_set_function(pin_sda, GPIO_FUNC_I2C);
+  gpio_set_function(pin_scl, GPIO_FUNC_I2C);
+  gpio_pull_up(pin_sda);
+  gpio_pull_up(pin_scl);
+}
+int i2c_bus_Register_Client(const char *name) {
+  (void)name;
+  return CLIENT_COUNT < I2C_BUS_MAX_CLIENTS ? CLIENT_COUNT++ : -1;
+}
+bool i2c_bus_Submit(i2c_inst_t *i2c, i2c_bus_tx_t *tx) {
+  tx->result = i2c_write_blocking(i2c, tx->addr, tx->data, tx->len, false);
+  tx->done = true;
+  return true;
+}
+bool i2c_bus_Try_Submit(i2c_inst_t *i2c, i2c_bus_tx_t *tx) {
+  return i2c_bus_Submit(i2c, tx);
+}
+int i2c_bus_Wait(i2c_bus_tx_t *tx, uint32_t timeout_ms) {
+  (void)timeout_ms;
+  return tx->result;
+}
+int i2c_bus_Write(i2c_inst_t *i2c, int client, uint8_t addr, const uint8_t *data, size_t len, i2c_bus_priority_t priority, bool mergeable, bool split) {
+  (void)client; (void)priority; (void)mergeable; (void)split;
+  return i2c_write_blocking(i2c, addr, data, len, false);
+}
+bool i2c_bus_Get_Stats(int client, const char **name, i2c_bus_stats_t *stats) {
+  (void)client; (void)name; (void)stats;
+  return false;
+}
@@ -1,10 +1,15 @@
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
 #include "hardware/clocks.h"
+#include "hardware/structs/io_bank0.h"
 #include "headers/buzzer_local.h"
 
 static int SLICE_NUM  = 0;
 static uint PIN = 0;
+static uint16_t STAGED_WRAP = 0;        // Nota preparada por buzzer_Stage
+static int STAGED_MS = 0;
+static volatile alarm_id_t STOP_ALARM = 0;  // Alarme que encerra a nota assíncrona
+static volatile uint32_t NOTE_SEQ = 0;      // Nota atual; o alarme de uma nota substituída não a encerra
 
 
 static void buzzer_control(uint PIN, bool turn_on) {
@@ -50,4 +55,41 @@ void buzzer_multiplay(int *notes, int *ms_s, int length) {
             buzzer_play_note(hz, ms);
         }
     }
-}
\ No newline at end of file
+}
+// Encerra a nota assíncrona (executado na interrupção do alarme)
+static int64_t buzzer_Stop_Callback(alarm_id_t id, void *user_data){
+    if ((uint32_t)(uintptr_t)user_data != NOTE_SEQ) return 0;  // Nota já substituída por buzzer_Latch
+    STOP_ALARM = 0;
+    buzzer_control(PIN, false);
+    return 0;
+}
+// Prepara uma nota sem tocar: wrap e slice ficam calculados para buzzer_Latch só escrever os registradores
+void buzzer_Stage(int hz, int ms){
+    STAGED_WRAP = 0;
+    if (hz <= 0) return; // Frequência inválida: buzzer_Latch não toca nada
+    SLICE_NUM = pwm_gpio_to_slice_num(PIN);
+    STAGED_WRAP = clock_get_hz(clk_sys) / hz - 1;
+    STAGED_MS = ms;
+}
+// Toca a nota preparada substituindo a anterior; só escreve registradores, para caber em seção crítica.
+// O fim da nota é agendado depois, por buzzer_Schedule_Stop.
+void buzzer_Latch(){
+    if (STAGED_WRAP == 0) return;
+    NOTE_SEQ++;
+    pwm_set_wrap(SLICE_NUM, STAGED_WRAP);
+    pwm_set_chan_level(SLICE_NUM, pwm_gpio_to_channel(PIN), STAGED_WRAP / 2); // Duty cycle de 50%
+    pwm_set_enabled(SLICE_NUM, true);
+    io_bank0_hw->io[PIN].ctrl = GPIO_FUNC_PWM << IO_BANK0_GPIO0_CTRL_FUNCSEL_LSB;  // Pads já configurados por buzzer_init
+}
+// Agenda o fim da nota tocada por buzzer_Latch, sem bloquear quem chama
+void buzzer_Schedule_Stop(){
+    if (STAGED_WRAP == 0) return;
+    if (STOP_ALARM) cancel_alarm(STOP_ALARM);
+    STOP_ALARM = add_alarm_in_ms(STAGED_MS, buzzer_Stop_Callback, (void *)(uintptr_t)NOTE_SEQ, true);
+}
+// Toca uma nota sem bloquear
+void buzzer_play_note_async(int hz, int ms){
+    buzzer_Stage(hz, ms);
+    buzzer_Latch();
+    buzzer_Schedule_Stop();
+}
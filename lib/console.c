@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "headers/console_local.h"
+#include "headers/phase_local.h"
+#include "headers/latch_local.h"
+#include "headers/i2c_bus_local.h"
+#include "headers/wdt_local.h"
+
+#define CONSOLE_LINE_LEN 48     // Tamanho máximo de um comando
+#define CONSOLE_BURST 64        // Caracteres lidos por rodada antes de ceder a CPU
+#define CONSOLE_PERIOD_MS 20    // Intervalo entre leituras quando não há dados
+#define CONSOLE_MAX_ARGS 5
+
+// Protocolo (um comando por linha, números em decimal):
+//   t <verde/vermelho> <amarelo> <noturno>   tempos das fases em ms
+//   c <indice 0-3> <r> <g> <b>                cor da matriz
+//   b <indice 0-3> <hz> <ms> <periodo>        alerta do buzzer
+//   a                                         aplica as alterações na próxima troca de fase
+//   d                                         descarta as alterações não aplicadas
+//   s                                         mostra parâmetros, desvio das trocas, defasagem entre saídas
+//                                             e o último boot a quente
+//   j                                         zera as estatísticas de desvio e defasagem
+//   i                                         mostra a latência de cada cliente do barramento I2C
+// Respostas: "ok", "err" ou o estado pedido.
+
+static console_params_t STAGING;            // Alterações sendo montadas pelo console
+static console_params_t PENDING;            // Conjunto pronto para ser aplicado na próxima fase
+static console_params_t CURRENT;            // Último conjunto aplicado (para "d" e "s")
+static volatile bool HAS_PENDING = false;
+
+static char LINE[CONSOLE_LINE_LEN];
+static int LINE_LEN = 0;
+static bool LINE_OVERFLOW = false;
+
+// Escreve só quando há um host conectado, para nunca segurar a stdio sem necessidade
+static void console_Reply(const char *msg){
+    if(stdio_usb_connected())puts(msg);
+}
+// Converte os argumentos numéricos da linha; retorna a quantidade lida ou -1 em caso de erro
+static int console_Parse_Args(const char *str, long *args){
+    int count = 0;
+    while(*str){
+        while(*str == ' ')str++;
+        if(!*str)break;
+        if(count == CONSOLE_MAX_ARGS)return -1;
+        char *end;
+        args[count++] = strtol(str, &end, 10);
+        if(end == str || (*end && *end != ' '))return -1;
+        str = end;
+    }
+    return count;
+}
+static bool console_In_Range(long value, long min, long max){
+    return value >= min && value <= max;
+}
+// Interpreta uma linha completa
+static void console_Execute(const char *line){
+    long args[CONSOLE_MAX_ARGS];
+    int argc = console_Parse_Args(line + 1, args);
+    bool ok = argc >= 0;
+    switch(line[0]){
+        case 't':
+            ok = ok && argc == 3 && console_In_Range(args[0], 50, 60000) && console_In_Range(args[1], 50, 60000) && console_In_Range(args[2], 50, 60000);
+            if(ok)for(int i = 0; i < 3; i++)STAGING.timers[i] = args[i];
+            break;
+        case 'c':
+            ok = ok && argc == 4 && console_In_Range(args[0], 0, 3) && console_In_Range(args[1], 0, 255) && console_In_Range(args[2], 0, 255) && console_In_Range(args[3], 0, 255);
+            if(ok)for(int i = 0; i < 3; i++)STAGING.colors[args[0]][i] = args[i+1];
+            break;
+        case 'b':
+            // A nota toca por alarme, sem bloquear a tarefa do buzzer, então a duração não depende do prazo do watchdog
+            ok = ok && argc == 4 && console_In_Range(args[0], 0, 3) && console_In_Range(args[1], 20, 20000) && console_In_Range(args[2], 0, 1500) && console_In_Range(args[3], 0, 60000);
+            if(ok)for(int i = 0; i < 3; i++)STAGING.beeps[args[0]][i] = args[i+1];
+            break;
+        case 'a':
+            ok = ok && argc == 0;
+            if(ok){
+                taskENTER_CRITICAL();
+                PENDING = STAGING;
+                HAS_PENDING = true;
+                taskEXIT_CRITICAL();
+            }
+            break;
+        case 'd':
+            ok = ok && argc == 0;
+            if(ok)STAGING = CURRENT;
+            break;
+        case 'j':
+            ok = ok && argc == 0;
+            if(ok){
+                phase_Reset_Stats();
+                latch_Reset_Stats();
+            }
+            break;
+        case 's':{
+            if(!stdio_usb_connected())return;
+            phase_stats_t stats = phase_Get_Stats();
+            latch_stats_t skew = latch_Get_Stats();
+            printf("t %d %d %d\n", CURRENT.timers[0], CURRENT.timers[1], CURRENT.timers[2]);
+            for(int i = 0; i < 4; i++)printf("c %d %d %d %d\n", i, CURRENT.colors[i][0], CURRENT.colors[i][1], CURRENT.colors[i][2]);
+            for(int i = 0; i < 4; i++)printf("b %d %d %d %d\n", i, CURRENT.beeps[i][0], CURRENT.beeps[i][1], CURRENT.beeps[i][2]);
+            printf("jitter fases=%lu ultimo=%lu us max=%lu us pendente=%d\n",
+                (unsigned long)stats.count, (unsigned long)stats.last_us, (unsigned long)stats.max_us, HAS_PENDING);
+            printf("defasagem trocas=%lu ultimo=%lu us max=%lu us saida=%lu\n",
+                (unsigned long)skew.count, (unsigned long)skew.last_us, (unsigned long)skew.max_us, (unsigned long)skew.max_output);
+            wdt_recovery_t recovery;
+            const char *hung;
+            if(wdt_Get_Recovery(&recovery, &hung)){
+                // Medido: do último check-in da tarefa (o travamento veio depois dele); senão, o pior caso
+                printf("wdt boot a quente tarefa=%s fase=%d %s=%lu ms reset->retomada=%lu us travamento->retomada<=%lu ms\n",
+                    hung, recovery.phase, recovery.measured ? "checkin->reset" : "travamento->reset<",
+                    (unsigned long)recovery.hang_to_reset_ms, (unsigned long)recovery.resume_us,
+                    (unsigned long)(recovery.hang_to_reset_ms + (recovery.resume_us + 999) / 1000));
+            }else printf("wdt boot a frio\n");
+            return;
+        }
+        case 'i':{
+            if(!stdio_usb_connected())return;
+            const char *name;
+            i2c_bus_stats_t stats;
+            for(int i = 0; i2c_bus_Get_Stats(i, &name, &stats); i++){
+                printf("i2c %d %s n=%lu erros=%lu ultimo=%lu us max=%lu us media=%lu us\n", i, name,
+                    (unsigned long)stats.count, (unsigned long)stats.errors, (unsigned long)stats.last_us,
+                    (unsigned long)stats.max_us, (unsigned long)(stats.count ? stats.total_us / stats.count : 0));
+            }
+            return;
+        }
+        default:
+            ok = false;
+    }
+    console_Reply(ok ? "ok" : "err");
+}
+// Lê da USB sem bloquear até CONSOLE_BURST caracteres e monta linhas em buffer fixo; retorna true se
+// o limite foi atingido (ainda há dados)
+static bool console_Poll(){
+    int burst = 0;
+    int c;
+    while(burst++ < CONSOLE_BURST && (c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT){
+        if(c == '\r' || c == '\n'){
+            LINE[LINE_LEN] = '\0';
+            if(LINE_OVERFLOW)console_Reply("err");
+            else if(LINE_LEN > 0)console_Execute(LINE);
+            LINE_LEN = 0;
+            LINE_OVERFLOW = false;
+        }else if(LINE_LEN < CONSOLE_LINE_LEN - 1){
+            LINE[LINE_LEN++] = c;
+        }else{
+            LINE_OVERFLOW = true;  // Descarta o resto da linha longa demais
+        }
+    }
+    return burst > CONSOLE_BURST;
+}
+// Tarefa de baixa prioridade: cede a CPU entre rajadas, mesmo sob uma enxurrada de comandos
+static void console_Task(){
+    while(true){
+        vTaskDelay(pdMS_TO_TICKS(console_Poll() ? 1 : CONSOLE_PERIOD_MS));
+    }
+}
+// Cria a tarefa do console a partir dos parâmetros atuais
+void console_Init(const console_params_t *current){
+    CURRENT = *current;
+    STAGING = *current;
+    xTaskCreate(console_Task, "console Task", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
+}
+// Chamada na troca de fase: copia o conjunto pendente, se houver, de uma só vez
+bool console_Take_Pending(console_params_t *params){
+    if(!HAS_PENDING)return false;
+    taskENTER_CRITICAL();
+    *params = PENDING;
+    CURRENT = PENDING;
+    HAS_PENDING = false;
+    taskEXIT_CRITICAL();
+    return true;
+}
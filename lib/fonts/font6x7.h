@@ -1,4 +1,4 @@
-uint8_t font[] = {
+const uint8_t font[] = {
     // 7, 7, 1, 32, 126,
     0x00,0x00,0x00,0x00,0x00,0x00,0x00, // space
     0x08,0x08,0x08,0x08,0x08,0x00,0x08, // !
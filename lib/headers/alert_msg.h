@@ -0,0 +1,11 @@
+#ifndef ALERT_MSG_H
+#define ALERT_MSG_H
+
+// Mensagens de alerta de cada fase, compartilhadas entre o firmware (main.c) e o gerador das telas
+// pré-renderizadas (tools/oled_screens_gen.c), que o build executa no host: mudar aqui atualiza os dois
+#define ALERT_MSG_COUNT 3
+#define ALERT_MSG_LIST {"Pode Atravessar", "Atencao", "Pare"}
+#define ALERT_MSG_X 2       // Posição do texto no display principal
+#define ALERT_MSG_Y 27
+
+#endif
@@ -7,5 +7,9 @@
 void buzzer_init(uint pin);
 void buzzer_play_note(int hz, int ms);
 void buzzer_multiplay(int *notes, int *ms_s, int length);
+void buzzer_Stage(int hz, int ms);
+void buzzer_Latch();
+void buzzer_Schedule_Stop();
+void buzzer_play_note_async(int hz, int ms);
 
 #endif 
\ No newline at end of file
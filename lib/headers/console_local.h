@@ -0,0 +1,17 @@
+#ifndef CONSOLE_LOCAL_H
+#define CONSOLE_LOCAL_H
+
+#include <stdlib.h>
+#include "pico/stdlib.h"
+
+// Parâmetros do semáforo ajustáveis pelo console
+typedef struct{
+    int timers[3];          // Verde/vermelho, amarelo e modo noturno (ms)
+    uint8_t colors[4][3];   // Cores da matriz (verde, amarelo, vermelho, apagado)
+    int beeps[4][3];        // Frequência (Hz), duração (ms) e período (ms) de cada alerta
+} console_params_t;
+
+void console_Init(const console_params_t *current);
+bool console_Take_Pending(console_params_t *params);
+
+#endif
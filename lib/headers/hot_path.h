@@ -0,0 +1,18 @@
+#ifndef HOT_PATH_H
+#define HOT_PATH_H
+
+#include "pico/stdlib.h"
+
+// Com a opção SEMAFORO_RAM_HOT_PATH do CMake, as funções marcadas com HOT_FUNC são copiadas
+// para a SRAM no boot (seção .time_critical), evitando esperas por falta no cache da flash (XIP).
+#ifndef SEMAFORO_RAM_HOT_PATH
+#define SEMAFORO_RAM_HOT_PATH 0
+#endif
+
+#if SEMAFORO_RAM_HOT_PATH
+#define HOT_FUNC(name) __not_in_flash_func(name)
+#else
+#define HOT_FUNC(name) name
+#endif
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef I2C_BUS_LOCAL_H
+#define I2C_BUS_LOCAL_H
+
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#define I2C_BUS_MAX_CLIENTS 8   // Quantidade máxima de clientes com estatísticas
+#define I2C_BUS_QUEUE_LEN 8     // Transações pendentes por prioridade em cada barramento
+#define I2C_BUS_CHUNK 128       // Bytes por fatia de uma escrita grande (permite intercalar as urgentes)
+#define I2C_BUS_MERGE_LEN 32    // Tamanho máximo de escritas agrupadas para o mesmo dispositivo
+#define I2C_BUS_WAIT_FOREVER 0xFFFFFFFFu  // Prazo de i2c_bus_Wait sem limite
+
+typedef enum{
+    I2C_BUS_URGENT = 0,         // Transações pequenas (comandos), passam à frente das grandes
+    I2C_BUS_NORMAL = 1          // Transações grandes (quadros do display)
+} i2c_bus_priority_t;
+
+// Transação de escrita; a memória é do cliente e deve existir até a conclusão
+typedef struct{
+    uint8_t addr;               // Endereço I2C do dispositivo
+    const uint8_t *data;        // Bytes a enviar
+    size_t len;                 // Quantidade de bytes
+    i2c_bus_priority_t priority;
+    bool mergeable;             // Pode ser concatenada a outras escritas agrupáveis para o mesmo endereço
+    bool split;                 // Pode ser enviada em fatias; data[0] é o byte de controle repetido em cada fatia.
+                                // Obrigatório (com prioridade normal) acima de I2C_BUS_CHUNK + 1 bytes
+    int client;                 // Cliente dono da transação (estatísticas)
+    volatile int result;        // Bytes escritos ou código de erro (< 0)
+    volatile bool done;         // Transação concluída
+    void *waiter;               // Tarefa aguardando a conclusão
+    uint32_t queued_us;         // Momento em que entrou na fila
+} i2c_bus_tx_t;
+
+// Estatísticas de latência (da submissão à conclusão) por cliente
+typedef struct{
+    uint32_t count, errors;
+    uint32_t last_us, max_us;
+    uint64_t total_us;
+} i2c_bus_stats_t;
+
+void i2c_bus_Init(i2c_inst_t *i2c, uint pin_sda, uint pin_scl, uint baudrate);
+int i2c_bus_Register_Client(const char *name);
+bool i2c_bus_Submit(i2c_inst_t *i2c, i2c_bus_tx_t *tx);
+bool i2c_bus_Try_Submit(i2c_inst_t *i2c, i2c_bus_tx_t *tx);
+int i2c_bus_Wait(i2c_bus_tx_t *tx, uint32_t timeout_ms);
+int i2c_bus_Write(i2c_inst_t *i2c, int client, uint8_t addr, const uint8_t *data, size_t len, i2c_bus_priority_t priority, bool mergeable, bool split);
+bool i2c_bus_Get_Stats(int client, const char **name, i2c_bus_stats_t *stats);
+
+#endif
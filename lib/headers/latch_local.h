@@ -0,0 +1,30 @@
+#ifndef LATCH_LOCAL_H
+#define LATCH_LOCAL_H
+
+#include <stdlib.h>
+#include "pico/stdlib.h"
+
+// Saídas acionadas juntas na troca de fase
+typedef enum{
+    LATCH_OLED,     // Painel religado com a imagem já enviada
+    LATCH_LEDS,     // Início do DMA da matriz WS2812
+    LATCH_RGB,      // Escrita da máscara do LED RGB
+    LATCH_BUZZER,   // Habilitação do PWM do buzzer
+    LATCH_OUTPUTS
+} latch_output_t;
+
+// Estatísticas da defasagem entre as saídas de uma mesma troca
+typedef struct{
+    uint32_t count;         // Trocas medidas
+    uint32_t last_us;       // Defasagem da última troca (primeira à última saída)
+    uint32_t max_us;        // Maior defasagem observada
+    uint32_t max_output;    // Saída que chegou por último na troca de maior defasagem
+} latch_stats_t;
+
+void latch_Begin();
+void latch_Mark(latch_output_t output);
+void latch_End();
+latch_stats_t latch_Get_Stats();
+void latch_Reset_Stats();
+
+#endif
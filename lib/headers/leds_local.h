@@ -4,8 +4,10 @@
 #include <stdlib.h>
 #include <pico/stdlib.h>
 
-void Leds_init(uint pin, int len_leds);
-void Leds_Map_leds_ON(uint8_t *LedsOn, uint8_t colorsOn[][3], int LedsOnCount, bool clear_cache);
+void Leds_init(uint pin, int len_leds, bool clear);
+void Leds_Map_leds_ON(const uint8_t *LedsOn, uint8_t colorsOn[][3], int LedsOnCount, bool clear_cache);
+void Leds_Stage(const uint8_t *LedsOn, uint8_t colorsOn[][3], int LedsOnCount, bool clear_cache);
+void Leds_Latch();
 void Leds_Clear_leds(bool clear_all);
 
 #endif
\ No newline at end of file
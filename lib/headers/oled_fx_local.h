@@ -0,0 +1,15 @@
+#ifndef OLED_FX_LOCAL_H
+#define OLED_FX_LOCAL_H
+
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "oled_local.h"
+
+void oled_Fx_Scroll(oled_t *oled, bool left, uint8_t speed);
+void oled_Fx_Scroll_Diagonal(oled_t *oled, bool left, uint8_t speed, uint8_t vertical_offset);
+void oled_Fx_Blink_Invert(oled_t *oled, uint32_t period_ms);
+void oled_Fx_Blink_Display(oled_t *oled, uint32_t period_ms);
+void oled_Fx_Fade(oled_t *oled, uint8_t from, uint8_t to, uint32_t duration_ms);
+bool oled_Fx_Stop(oled_t *oled);
+
+#endif
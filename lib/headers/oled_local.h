@@ -3,14 +3,25 @@
 
 #include <stdlib.h>
 #include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
 
-void oled_Init(uint pin_i2c_sda, uint pin_i2c_scl);
-void oled_Draw_draw(uint8_t draw[], uint8_t x, uint8_t y, uint8_t width, uint8_t height);
-void oled_Write_Char(char c, uint8_t x, uint8_t y);
-void oled_Write_String(const char *str, uint8_t x, uint8_t y);
-void oled_Draw_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool value, bool fill);
-void oled_Bold_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
-void oled_Update();
-void oled_Clear();
+// Handle de um display: buffer, geometria, endereço e barramento próprios
+typedef ssd1306_t oled_t;
+
+void oled_Init(oled_t *oled, const char *name, i2c_inst_t *i2c, uint pin_i2c_sda, uint pin_i2c_scl, uint8_t address, uint8_t width, uint8_t height, bool configure);
+void oled_Draw_draw(oled_t *oled, uint8_t draw[], uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+void oled_Write_Char(oled_t *oled, char c, uint8_t x, uint8_t y);
+void oled_Write_String(oled_t *oled, const char *str, uint8_t x, uint8_t y);
+void oled_Draw_Rectangle(oled_t *oled, uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool value, bool fill);
+void oled_Bold_Rectangle(oled_t *oled, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+bool oled_Show_Prerendered(oled_t *oled, const char *str, uint8_t x, uint8_t y);
+void oled_Update(oled_t *oled);
+void oled_Update_Async(oled_t *oled);
+int oled_Update_Wait(oled_t *oled, uint32_t timeout_ms);
+uint32_t oled_Update_All(oled_t *const oleds[], int count);
+void oled_Stage(oled_t *oled);
+void oled_Latch(oled_t *oled);
+void oled_Clear(oled_t *oled);
 
 #endif
@@ -0,0 +1,22 @@
+#ifndef OLED_SCREENS_H
+#define OLED_SCREENS_H
+
+#include <stdlib.h>
+#include "pico/stdlib.h"
+
+#define OLED_SCREENS_WIDTH 128  // Geometria para a qual tools/oled_screens_gen.c rasteriza as telas
+#define OLED_SCREENS_HEIGHT 64
+
+// Tela fixa pré-renderizada (gerada no build por tools/oled_screens_gen.c) e armazenada em flash
+typedef struct {
+  const char *text;      // Mensagem que a tela representa
+  uint8_t x, y;          // Posição em que a mensagem foi rasterizada
+  bool rle;              // true: dados em pares (quantidade, valor); false: imagem bruta com byte 0x40 inicial
+  const uint8_t *data;   // Imagem em flash
+  size_t len;            // Tamanho de data em bytes
+} oled_screen_t;
+
+extern const oled_screen_t OLED_SCREENS[];
+extern const size_t OLED_SCREENS_COUNT;
+
+#endif
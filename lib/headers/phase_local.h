@@ -0,0 +1,22 @@
+#ifndef PHASE_LOCAL_H
+#define PHASE_LOCAL_H
+
+#include <stdlib.h>
+#include "pico/stdlib.h"
+
+// Estatísticas de pontualidade das trocas de fase
+typedef struct{
+    uint32_t count;         // Trocas de fase medidas
+    uint32_t last_us;       // Desvio da última troca em relação ao previsto
+    uint32_t max_us;        // Maior desvio observado
+} phase_stats_t;
+
+int phase_Next(int phase);
+int phase_Duration(int phase, bool night_mode, const int timers[3]);
+int phase_Leds_Index(int phase, bool night_mode);
+int phase_Alert_Index(int phase, bool night_mode);
+void phase_Mark_Start(int expected_ms);
+phase_stats_t phase_Get_Stats();
+void phase_Reset_Stats();
+
+#endif
@@ -4,8 +4,9 @@
 #include <stdlib.h>  // Inclui funções de manipulação de memória e alocação
 #include "pico/stdlib.h"  // Biblioteca padrão do Raspberry Pi Pico
 #include "hardware/i2c.h"  // Inclui a biblioteca I2C para comunicação com o dispositivo
+#include "i2c_bus_local.h"  // Gerenciador do barramento I2C compartilhado
 
-extern uint8_t WIDTH, HEIGHT;
+#define SSD1306_RLE_CHUNK 32  // Quantidade de bytes enviados por transação ao descomprimir imagens RLE
 // Enumeração dos comandos para o controle do display SSD1306
 typedef enum {
   SET_CONTRAST = 0x81,  // Define o comando para configurar o contraste
@@ -24,8 +25,15 @@ typedef enum {
   SET_DISP_CLK_DIV = 0xD5,  // Comando para configurar o divisor de clock
   SET_PRECHARGE = 0xD9,  // Comando para configurar o tempo de pré-carga
   SET_VCOM_DESEL = 0xDB,  // Comando para configurar a seleção de VCOM
-  SET_CHARGE_PUMP = 0x8D  // Comando para ativar a bomba de carga
+  SET_CHARGE_PUMP = 0x8D,  // Comando para ativar a bomba de carga
+  SET_HSCROLL = 0x26,  // Rolagem horizontal contínua para a direita (| 0x01 para a esquerda)
+  SET_VHSCROLL = 0x29,  // Rolagem vertical e horizontal contínua para a direita (+ 0x01 para a esquerda)
+  SET_SCROLL_OFF = 0x2E,  // Desativa a rolagem
+  SET_SCROLL_ON = 0x2F,  // Ativa a rolagem configurada
+  SET_VSCROLL_AREA = 0xA3,  // Define a área de rolagem vertical
+  SET_FADE = 0x23  // Configura o esmaecimento (fade out) ou piscar automático do controlador
 } ssd1306_command_t;
+#define SSD1306_MAX_COMMANDS 16  // Comandos enviados em uma única transação por ssd1306_command_list
 // Estrutura para representar o display SSD1306
 typedef struct {
   uint8_t width, height, pages, address;  // Propriedades do display (largura, altura, páginas, endereço I2C)
@@ -34,13 +42,23 @@ typedef struct {
   uint8_t *ram_buffer;  // Buffer de memória RAM para armazenar os dados a serem exibidos
   size_t bufsize;  // Tamanho do buffer de dados
   uint8_t port_buffer[2];  // Buffer para armazenar dados e comandos para comunicação I2C
+  int client;  // Cliente do gerenciador de barramento I2C (estatísticas de latência)
+  i2c_bus_tx_t window_tx, data_tx;  // Transações da atualização assíncrona (janela e quadro)
+  uint8_t window_buffer[12];  // Comandos de janela da atualização assíncrona
+  bool scrolling;  // Rolagem do controlador ativa
 } ssd1306_t;
 // Funções para inicializar e configurar o display SSD1306
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, const char *name);
 void ssd1306_config(ssd1306_t *ssd);  // Função de configuração do display
 // Funções para enviar comandos e dados ao display
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);  // Envia um comando ao display
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, uint8_t count);  // Envia vários comandos em uma transação
+bool ssd1306_command_async(ssd1306_t *ssd, i2c_bus_tx_t *tx, uint8_t *buffer, const uint8_t *commands, uint8_t count);  // Idem, sem esperar
 void ssd1306_send_data(ssd1306_t *ssd);  // Envia dados para o display
+bool ssd1306_send_data_async(ssd1306_t *ssd);  // Inicia o envio dos dados sem esperar
+int ssd1306_wait(ssd1306_t *ssd, uint32_t timeout_ms);  // Espera o envio assíncrono terminar
+void ssd1306_send_image(ssd1306_t *ssd, const uint8_t *image, size_t len);  // Envia uma imagem bruta direto da flash
+void ssd1306_send_rle(ssd1306_t *ssd, const uint8_t *rle, size_t len);  // Envia uma imagem RLE direto da flash
 // Funções para desenhar no display (pixels, linhas, retângulos, etc.)
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);  // Desenha um pixel
 void ssd1306_fill(ssd1306_t *ssd, bool value);  // Preenche o display com um valor
@@ -48,5 +66,13 @@ void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);  // Desenha uma linha
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);  // Desenha uma linha horizontal
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);  // Desenha uma linha vertical
+// Efeitos executados pelo próprio controlador (poucos bytes no barramento, sem reenviar a imagem)
+void ssd1306_scroll_h(ssd1306_t *ssd, bool left, uint8_t start_page, uint8_t end_page, uint8_t interval);  // Rolagem horizontal
+void ssd1306_scroll_diag(ssd1306_t *ssd, bool left, uint8_t start_page, uint8_t end_page, uint8_t interval, uint8_t vertical_offset);  // Rolagem diagonal
+void ssd1306_scroll_stop(ssd1306_t *ssd);  // Para a rolagem (a imagem precisa ser reenviada depois)
+void ssd1306_contrast(ssd1306_t *ssd, uint8_t value);  // Define o contraste
+void ssd1306_invert(ssd1306_t *ssd, bool invert);  // Inverte as cores da tela
+void ssd1306_display_on(ssd1306_t *ssd, bool on);  // Liga ou apaga o painel sem perder a imagem
+void ssd1306_fade(ssd1306_t *ssd, uint8_t mode, uint8_t interval);  // Esmaecimento/piscar do controlador (mode 0, 2 ou 3)
 
 #endif  // Fim da definição de SSD1306_H
@@ -0,0 +1,27 @@
+#ifndef WDT_LOCAL_H
+#define WDT_LOCAL_H
+
+#include <stdlib.h>
+#include "pico/stdlib.h"
+
+#define WDT_MAX_TASKS 8  // Quantidade máxima de tarefas supervisionadas
+
+// Relato do último boot a quente
+typedef struct{
+    bool valid;             // Houve boot a quente desde a energização
+    int phase;              // Fase retomada
+    int hung;               // Id da tarefa que travou (-1 se desconhecida)
+    bool measured;          // hang_to_reset_ms medido pelo supervisor (senão é o pior caso)
+    uint32_t hang_to_reset_ms;  // Do último check-in da tarefa travada até o reset
+    uint32_t resume_us;     // Tempo do reset até a fase ser retomada
+} wdt_recovery_t;
+
+void wdt_Init(uint32_t timeout_ms);
+int wdt_Register(const char *name, uint32_t deadline_ms);
+void wdt_Check_In(int id);
+void wdt_Save_State(int phase, bool night_mode);
+bool wdt_Warm_Boot(int *phase, bool *night_mode, uint32_t *elapsed_ms);
+void wdt_Record_Recovery(int phase);
+bool wdt_Get_Recovery(wdt_recovery_t *recovery, const char **hung_name);
+
+#endif
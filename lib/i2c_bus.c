@@ -0,0 +1,286 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "headers/i2c_bus_local.h"
+
+// Estado de cada barramento: uma tarefa dona do periférico e uma fila por prioridade
+typedef struct{
+    i2c_inst_t *i2c;
+    uint pin_sda, pin_scl, baudrate;
+    QueueHandle_t queues[2];                    // Indexadas por i2c_bus_priority_t
+    TaskHandle_t task;
+    i2c_bus_tx_t *bulk;                         // Escrita grande sendo enviada em fatias
+    size_t bulk_offset;                         // Próximo byte da escrita grande
+    uint8_t buffer[I2C_BUS_CHUNK + 1];          // Fatia atual ou escritas agrupadas
+    i2c_bus_tx_t *merged[I2C_BUS_QUEUE_LEN];    // Transações agrupadas no envio atual
+    uint16_t commands[I2C_BUS_CHUNK + 1];       // Palavras de IC_DATA_CMD lidas pelo DMA (byte + bit de STOP)
+    int dma_chan;
+    SemaphoreHandle_t stop;                     // Dado pela interrupção quando a transferência termina (STOP)
+    volatile uint32_t abort_source;             // Motivo do aborto (ex.: NAK), zero se a escrita foi aceita
+} I2cBus;
+
+static I2cBus BUSES[2];
+static const char *CLIENT_NAMES[I2C_BUS_MAX_CLIENTS];
+static i2c_bus_stats_t CLIENT_STATS[I2C_BUS_MAX_CLIENTS];
+static int CLIENT_COUNT = 0;
+
+// Linha em dreno aberto: nível alto é a linha solta (pull-up), nível baixo é a linha forçada
+static void i2c_bus_Line(uint pin, bool high){
+    gpio_set_dir(pin, high ? GPIO_IN : GPIO_OUT);
+    sleep_us(5);
+}
+// Configura o periférico e os pinos do barramento
+static void i2c_bus_Setup(I2cBus *bus){
+    i2c_init(bus->i2c, bus->baudrate);
+    gpio_set_function(bus->pin_sda, GPIO_FUNC_I2C);
+    gpio_set_function(bus->pin_scl, GPIO_FUNC_I2C);
+    gpio_pull_up(bus->pin_sda);
+    gpio_pull_up(bus->pin_scl);
+    i2c_hw_t *hw = i2c_get_hw(bus->i2c);
+    hw->intr_mask = 0;          // Após o reset várias interrupções vêm habilitadas; só as do DMA são ligadas, por transferência
+    hw->dma_tdlr = 8;           // Pede DMA com a FIFO pela metade, para ela nunca esvaziar no meio da escrita
+}
+// Libera um escravo que segura SDA em nível baixo: até 9 pulsos em SCL seguidos de um STOP
+static void i2c_bus_Recover(I2cBus *bus){
+    i2c_deinit(bus->i2c);
+    gpio_set_function(bus->pin_sda, GPIO_FUNC_SIO);
+    gpio_set_function(bus->pin_scl, GPIO_FUNC_SIO);
+    gpio_put(bus->pin_sda, false);
+    gpio_put(bus->pin_scl, false);
+    i2c_bus_Line(bus->pin_sda, true);
+    i2c_bus_Line(bus->pin_scl, true);
+    for(int i = 0; i < 9 && !gpio_get(bus->pin_sda); i++){
+        i2c_bus_Line(bus->pin_scl, false);
+        i2c_bus_Line(bus->pin_scl, true);
+    }
+    i2c_bus_Line(bus->pin_scl, false);  // STOP: SDA sobe com SCL em nível alto
+    i2c_bus_Line(bus->pin_sda, false);
+    i2c_bus_Line(bus->pin_scl, true);
+    i2c_bus_Line(bus->pin_sda, true);
+    i2c_bus_Setup(bus);
+}
+// Interrupção do controlador: o aborto para o DMA e o STOP (que vem também depois de um aborto) acorda a tarefa
+static void i2c_bus_Irq(I2cBus *bus){
+    i2c_hw_t *hw = i2c_get_hw(bus->i2c);
+    uint32_t status = hw->intr_stat;
+    BaseType_t woken = pdFALSE;
+    if(status & I2C_IC_INTR_STAT_R_TX_ABRT_BITS){
+        bus->abort_source = hw->tx_abrt_source;
+        dma_channel_abort(bus->dma_chan);  // A FIFO fica descartando escritas até o aborto ser limpo
+        (void)hw->clr_tx_abrt;
+    }
+    if(status & I2C_IC_INTR_STAT_R_STOP_DET_BITS){
+        (void)hw->clr_stop_det;
+        xSemaphoreGiveFromISR(bus->stop, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+static void i2c_bus_Irq0(){ i2c_bus_Irq(&BUSES[0]); }
+static void i2c_bus_Irq1(){ i2c_bus_Irq(&BUSES[1]); }
+// Escreve com prazo proporcional ao tamanho (o dobro do tempo de linha) e recupera o barramento se estourar.
+// Com o escalonador rodando, o DMA alimenta a FIFO e a tarefa fica bloqueada até o STOP: a CPU fica livre
+// durante a transferência e barramentos diferentes transmitem de fato ao mesmo tempo.
+static int i2c_bus_Transfer(I2cBus *bus, uint8_t addr, const uint8_t *data, size_t len){
+    uint32_t timeout_us = len * (20000000u / bus->baudrate) + 1000;
+    if(xTaskGetSchedulerState() != taskSCHEDULER_RUNNING){
+        // Antes do escalonador: envio por consulta, sem limite de tamanho
+        int result = i2c_write_timeout_us(bus->i2c, addr, data, len, false, timeout_us);
+        if(result == PICO_ERROR_TIMEOUT)i2c_bus_Recover(bus);
+        return result;
+    }
+    if(len == 0 || len > I2C_BUS_CHUNK + 1)return PICO_ERROR_INVALID_ARG;  // Não cabe no buffer do DMA
+    i2c_hw_t *hw = i2c_get_hw(bus->i2c);
+    for(size_t i = 0; i < len; i++)bus->commands[i] = data[i];
+    bus->commands[len - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    hw->enable = 0;
+    hw->tar = addr;
+    hw->enable = 1;
+    bus->abort_source = 0;
+    xSemaphoreTake(bus->stop, 0);  // Descarta um STOP antigo
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+    dma_channel_set_read_addr(bus->dma_chan, bus->commands, false);
+    dma_channel_set_trans_count(bus->dma_chan, len, true);
+    bool stopped = xSemaphoreTake(bus->stop, pdMS_TO_TICKS(timeout_us / 1000 + 1)) == pdTRUE;
+    hw->intr_mask = 0;
+    if(!stopped){
+        dma_channel_abort(bus->dma_chan);
+        i2c_bus_Recover(bus);
+        return PICO_ERROR_TIMEOUT;
+    }
+    return bus->abort_source ? PICO_ERROR_GENERIC : (int)len;
+}
+// Conclui a transação, atualiza as estatísticas do cliente e acorda quem espera
+static void i2c_bus_Complete(i2c_bus_tx_t *tx, int result){
+    uint32_t latency = time_us_32() - tx->queued_us;
+    void *waiter = tx->waiter;  // Lido antes de done: depois disso o cliente pode reutilizar tx
+    if(tx->client >= 0 && tx->client < CLIENT_COUNT){
+        // Seção crítica só com o escalonador rodando: antes disso ela deixaria as interrupções desligadas
+        bool running = xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+        if(running)taskENTER_CRITICAL();
+        i2c_bus_stats_t *stats = &CLIENT_STATS[tx->client];
+        stats->count++;
+        if(result < 0)stats->errors++;
+        stats->last_us = latency;
+        stats->total_us += latency;
+        if(latency > stats->max_us)stats->max_us = latency;
+        if(running)taskEXIT_CRITICAL();
+    }
+    tx->result = result;
+    tx->done = true;
+    if(waiter)xTaskNotifyGive((TaskHandle_t)waiter);
+}
+// Envia uma transação; escritas agrupáveis seguintes para o mesmo endereço vão na mesma transferência
+static void i2c_bus_Process(I2cBus *bus, i2c_bus_tx_t *tx, QueueHandle_t queue, bool allow_bulk){
+    if(allow_bulk && tx->split && tx->len > I2C_BUS_CHUNK + 1){
+        bus->bulk = tx;  // Enviada aos poucos, com as urgentes intercaladas entre as fatias
+        bus->bulk_offset = 1;
+        return;
+    }
+    if(tx->mergeable && tx->len <= I2C_BUS_MERGE_LEN){
+        i2c_bus_tx_t *next;
+        size_t len = tx->len;
+        int count = 1;
+        bus->merged[0] = tx;
+        memcpy(bus->buffer, tx->data, len);
+        while(count < I2C_BUS_QUEUE_LEN && xQueuePeek(queue, &next, 0) == pdTRUE &&
+              next->mergeable && next->addr == tx->addr && len + next->len <= I2C_BUS_MERGE_LEN){
+            xQueueReceive(queue, &next, 0);
+            memcpy(bus->buffer + len, next->data, next->len);
+            len += next->len;
+            bus->merged[count++] = next;
+        }
+        if(count > 1){
+            int result = i2c_bus_Transfer(bus, tx->addr, bus->buffer, len);
+            for(int i = 0; i < count; i++)i2c_bus_Complete(bus->merged[i], result < 0 ? result : (int)bus->merged[i]->len);
+            return;
+        }
+    }
+    i2c_bus_Complete(tx, i2c_bus_Transfer(bus, tx->addr, tx->data, tx->len));
+}
+// Envia a próxima fatia da escrita grande, repetindo o byte de controle
+static void i2c_bus_Bulk_Step(I2cBus *bus){
+    i2c_bus_tx_t *tx = bus->bulk;
+    size_t n = tx->len - bus->bulk_offset;
+    if(n > I2C_BUS_CHUNK)n = I2C_BUS_CHUNK;
+    bus->buffer[0] = tx->data[0];
+    memcpy(bus->buffer + 1, tx->data + bus->bulk_offset, n);
+    int result = i2c_bus_Transfer(bus, tx->addr, bus->buffer, n + 1);
+    bus->bulk_offset += n;
+    if(result < 0 || bus->bulk_offset >= tx->len){
+        bus->bulk = NULL;
+        i2c_bus_Complete(tx, result < 0 ? result : (int)tx->len);
+    }
+}
+// Tarefa dona do barramento: urgentes primeiro, depois a escrita grande em andamento, depois as normais
+static void i2c_bus_Task(void *param){
+    I2cBus *bus = param;
+    i2c_bus_tx_t *tx;
+    while(true){
+        if(xQueueReceive(bus->queues[I2C_BUS_URGENT], &tx, 0) == pdTRUE)i2c_bus_Process(bus, tx, bus->queues[I2C_BUS_URGENT], false);
+        else if(bus->bulk)i2c_bus_Bulk_Step(bus);
+        else if(xQueueReceive(bus->queues[I2C_BUS_NORMAL], &tx, 0) == pdTRUE)i2c_bus_Process(bus, tx, bus->queues[I2C_BUS_NORMAL], true);
+        else ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+// Configura o barramento (liberando um escravo preso) e cria sua tarefa; chamadas seguintes não fazem nada
+void i2c_bus_Init(i2c_inst_t *i2c, uint pin_sda, uint pin_scl, uint baudrate){
+    I2cBus *bus = &BUSES[i2c_get_index(i2c)];
+    if(bus->task)return;  // Já configurado por outro display no mesmo barramento
+    bus->i2c = i2c;
+    bus->pin_sda = pin_sda;
+    bus->pin_scl = pin_scl;
+    bus->baudrate = baudrate;
+    i2c_bus_Recover(bus);
+    // DMA de 16 bits para IC_DATA_CMD no ritmo da FIFO de transmissão (i2c_init já habilita o pedido de DMA)
+    bus->dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(bus->dma_chan);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, i2c_get_dreq(i2c, true));
+    dma_channel_configure(bus->dma_chan, &config, &i2c_get_hw(i2c)->data_cmd, bus->commands, 0, false);
+    bus->stop = xSemaphoreCreateBinary();
+    uint irq = i2c_get_index(i2c) ? I2C1_IRQ : I2C0_IRQ;
+    irq_set_exclusive_handler(irq, i2c_get_index(i2c) ? i2c_bus_Irq1 : i2c_bus_Irq0);
+    irq_set_enabled(irq, true);
+    bus->queues[I2C_BUS_URGENT] = xQueueCreate(I2C_BUS_QUEUE_LEN, sizeof(i2c_bus_tx_t *));
+    bus->queues[I2C_BUS_NORMAL] = xQueueCreate(I2C_BUS_QUEUE_LEN, sizeof(i2c_bus_tx_t *));
+    xTaskCreate(i2c_bus_Task, "i2c_bus Task", configMINIMAL_STACK_SIZE, bus, tskIDLE_PRIORITY+2, &bus->task);
+}
+// Registra um cliente para as estatísticas; retorna o id ou -1
+int i2c_bus_Register_Client(const char *name){
+    if(CLIENT_COUNT >= I2C_BUS_MAX_CLIENTS)return -1;
+    CLIENT_NAMES[CLIENT_COUNT] = name;
+    return CLIENT_COUNT++;
+}
+// Coloca a transação na fila esperando até wait ticks por espaço; se a fila seguir cheia a transação
+// é concluída com erro, para que i2c_bus_Wait não espere por algo que nunca foi enfileirado.
+// Com o escalonador rodando, só escritas normais com split podem passar de uma fatia (vão pelo caminho
+// em fatias); as demais são recusadas com PICO_ERROR_INVALID_ARG em vez de ocupar a CPU por consulta.
+static bool i2c_bus_Enqueue(i2c_inst_t *i2c, i2c_bus_tx_t *tx, TickType_t wait){
+    I2cBus *bus = &BUSES[i2c_get_index(i2c)];
+    tx->done = false;
+    tx->result = 0;
+    tx->queued_us = time_us_32();
+    if(!bus->task || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING){
+        tx->waiter = NULL;
+        i2c_bus_Complete(tx, bus->baudrate ? i2c_bus_Transfer(bus, tx->addr, tx->data, tx->len)
+                                           : i2c_write_blocking(i2c, tx->addr, tx->data, tx->len, false));
+        return true;
+    }
+    if(tx->len > I2C_BUS_CHUNK + 1 && !(tx->split && tx->priority == I2C_BUS_NORMAL)){
+        tx->waiter = NULL;
+        i2c_bus_Complete(tx, PICO_ERROR_INVALID_ARG);
+        return false;
+    }
+    tx->waiter = xTaskGetCurrentTaskHandle();
+    if(xQueueSend(bus->queues[tx->priority], &tx, wait) != pdTRUE){
+        tx->waiter = NULL;
+        i2c_bus_Complete(tx, PICO_ERROR_GENERIC);
+        return false;
+    }
+    xTaskNotifyGive(bus->task);
+    return true;
+}
+// Coloca a transação na fila do barramento e retorna sem esperar a transferência.
+// Antes do escalonador iniciar, a transação é executada na hora por quem chamou.
+bool i2c_bus_Submit(i2c_inst_t *i2c, i2c_bus_tx_t *tx){
+    return i2c_bus_Enqueue(i2c, tx, pdMS_TO_TICKS(100));
+}
+// Igual a i2c_bus_Submit, mas nunca bloqueia (para callbacks de timers): com a fila cheia falha na hora
+bool i2c_bus_Try_Submit(i2c_inst_t *i2c, i2c_bus_tx_t *tx){
+    return i2c_bus_Enqueue(i2c, tx, 0);
+}
+// Espera a conclusão de uma transação submetida; retorna o resultado ou PICO_ERROR_TIMEOUT
+int i2c_bus_Wait(i2c_bus_tx_t *tx, uint32_t timeout_ms){
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(timeout_ms);
+    while(!tx->done){
+        TickType_t waited = xTaskGetTickCount() - start;
+        if(waited >= timeout)return PICO_ERROR_TIMEOUT;
+        ulTaskNotifyTake(pdTRUE, timeout - waited);
+    }
+    return tx->result;
+}
+// Escrita síncrona: submete e espera (o prazo de cada transferência limita a espera)
+int i2c_bus_Write(i2c_inst_t *i2c, int client, uint8_t addr, const uint8_t *data, size_t len, i2c_bus_priority_t priority, bool mergeable, bool split){
+    i2c_bus_tx_t tx = {.addr = addr, .data = data, .len = len, .priority = priority,
+                       .mergeable = mergeable, .split = split, .client = client};
+    if(!i2c_bus_Submit(i2c, &tx))return PICO_ERROR_GENERIC;
+    return i2c_bus_Wait(&tx, I2C_BUS_WAIT_FOREVER);
+}
+// Copia as estatísticas de um cliente; retorna false se o id não existe
+bool i2c_bus_Get_Stats(int client, const char **name, i2c_bus_stats_t *stats){
+    if(client < 0 || client >= CLIENT_COUNT)return false;
+    taskENTER_CRITICAL();
+    *name = CLIENT_NAMES[client];
+    *stats = CLIENT_STATS[client];
+    taskEXIT_CRITICAL();
+    return true;
+}
@@ -1,10 +1,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "pico/stdlib.h"     // Biblioteca padrão do Raspberry Pi Pico
+#include "hardware/irq.h"
+#include "hardware/structs/io_bank0.h"
+#include "hardware/structs/timer.h"
 #include "headers/interrupt_local.h"       // Cabeçalho para funções de interrupção
+#include "headers/hot_path.h"       // Posicionamento das rotinas quentes na SRAM
 
 static uint32_t LAST_TIME = 0;  // Variável para armazenar o último tempo da interrupção (para debounce)
 static uint32_t WAIT_TIME = 200000;  // Tempo de debounce em microssegundos
+static uint32_t PINS = 0;  // Pinos atendidos pelo tratador de IRQ
 
 // Estrutura que contém um ponteiro para função de callback
 typedef struct{
@@ -13,19 +18,30 @@ typedef struct{
 CallbackFunction callback_function; // Instância da estrutura de callback
 
 // Função para verificar se já passou tempo suficiente para considerar um novo acionamento (debounce)
-static bool itr_Debounce(){
-  uint32_t current_time = to_us_since_boot(get_absolute_time()); // Obtém o tempo atual em microssegundos
+static bool HOT_FUNC(itr_Debounce)(){
+  uint32_t current_time = timer_hw->timerawl; // Tempo atual em microssegundos, lido direto do timer (sem código na flash)
   bool valid_time = current_time - LAST_TIME > WAIT_TIME; // Verifica se o tempo de debounce foi atingido
   if(valid_time) LAST_TIME = current_time; // Atualiza o tempo da última interrupção válida
   return valid_time; // Retorna se o evento é válido
 }
 
 // Callback executado quando ocorre uma interrupção no botão
-static void itr_Button_Callback(uint gpio, uint32_t events) {
+static void HOT_FUNC(itr_Button_Callback)(uint gpio, uint32_t events) {
   if(itr_Debounce()){ // Executa a função de callback apenas se o debounce permitir
     callback_function.func(gpio, events);
   }
 }
+// Tratador ligado direto ao vetor IO_IRQ_BANK0, sempre na SRAM: não passa pelo despachante de GPIO do SDK (na flash)
+static void __not_in_flash_func(itr_Irq_Handler)(){
+  uint32_t pins = PINS;
+  for(uint pin = 0; pins; pin++, pins >>= 1){
+    if(!(pins & 1))continue;
+    uint32_t events = (io_bank0_hw->proc0_irq_ctrl.ints[pin / 8] >> (4 * (pin % 8))) & 0xF;
+    if(!events)continue;
+    io_bank0_hw->intr[pin / 8] = events << (4 * (pin % 8)); // Reconhece as bordas
+    itr_Button_Callback(pin, events);
+  }
+}
 // Define a função de callback e o tempo de debounce(pode ser 0={fica 200000 padrão})
 void itr_SetCallbackFunction(void (*func)(uint, uint32_t)){
     callback_function.func = func;
@@ -35,6 +51,11 @@ void itr_Interruption(uint pin){
   gpio_init(pin);
   gpio_set_dir(pin, GPIO_IN);
   gpio_pull_up(pin);
-  gpio_set_irq_enabled_with_callback(pin, GPIO_IRQ_EDGE_FALL, true, &itr_Button_Callback);
+  if(!PINS){
+    irq_set_exclusive_handler(IO_IRQ_BANK0, itr_Irq_Handler);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+  }
+  PINS |= 1u << pin;
+  gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_FALL, true);
   // Ativa a interrupção no pino, acionada na borda de descida (pressionar botão)
 }
@@ -0,0 +1,47 @@
+#include "pico/stdlib.h"
+#include "headers/latch_local.h"
+#include "headers/hot_path.h"
+
+// Cada saída marca o instante em que foi acionada; a defasagem é a distância entre a primeira e a última
+
+static latch_stats_t STATS = {0};
+static uint32_t MARKS[LATCH_OUTPUTS];
+static uint8_t MARKED = 0;   // Bits das saídas acionadas na troca atual
+
+// Inicia a medição de uma troca
+void latch_Begin(){
+    MARKED = 0;
+}
+// Registra o acionamento de uma saída; chamada logo após a escrita no periférico
+void HOT_FUNC(latch_Mark)(latch_output_t output){
+    MARKS[output] = time_us_32();
+    MARKED |= 1u << output;
+}
+// Fecha a troca e atualiza as estatísticas (com uma saída só a defasagem é zero)
+void latch_End(){
+    uint32_t first = 0, last = 0;
+    int last_output = -1;
+    for(int i = 0; i < LATCH_OUTPUTS; i++){
+        if(!(MARKED & (1u << i)))continue;
+        if(last_output < 0 || (int32_t)(MARKS[i] - first) < 0)first = MARKS[i];
+        if(last_output < 0 || (int32_t)(MARKS[i] - last) >= 0){
+            last = MARKS[i];
+            last_output = i;
+        }
+    }
+    if(last_output < 0)return;
+    STATS.last_us = last - first;
+    if(STATS.last_us >= STATS.max_us){
+        STATS.max_us = STATS.last_us;
+        STATS.max_output = last_output;
+    }
+    STATS.count++;
+}
+// Retorna uma cópia das estatísticas de defasagem
+latch_stats_t latch_Get_Stats(){
+    return STATS;
+}
+// Zera as estatísticas de defasagem
+void latch_Reset_Stats(){
+    STATS = (latch_stats_t){0};
+}
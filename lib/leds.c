@@ -1,8 +1,10 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
+#include "hardware/dma.h"
 #include "ws2812.pio.h"
 #include <string.h>
 #include "headers/leds_local.h"
+#include "headers/hot_path.h"
 
 #define MAX_LEDS 100 // Quantidade máxima de LEDs que podem ser controlados
 PIO pio = pio0; // PIO usada para controlar os LEDs
@@ -10,23 +12,29 @@ uint sm = 0; // Máquina de estados usada para controlar os LEDs
 static int LED_COUNT; // Quantidade de LEDs controlados
 static uint8_t colors[MAX_LEDS][3] = {0}; // Array para armazenar as cores dos LEDs
 
+static uint32_t grb[MAX_LEDS]; // Array para armazenar as cores em formato GRB, já no formato esperado pela PIO
+static int DMA_CHAN = -1; // Canal de DMA que copia grb para a PIO em Leds_Latch
+
 // Função para Conversão de cores RGB para GRB
-static void Leds_rgb_to_grb(uint8_t colors[MAX_LEDS][3]) {
-    // Array para armazenar as cores em formato GRB
-    uint32_t grb[LED_COUNT];
+static void HOT_FUNC(Leds_rgb_to_grb)(uint8_t colors[MAX_LEDS][3]) {
     // Itera sobre os LEDs e faz a conversão de RGB para GRB
     for (int i = 0; i < LED_COUNT; i++) {
         // Pega a cor atual em formato RGB
         uint8_t r = colors[i][0];
         uint8_t g = colors[i][1];
         uint8_t b = colors[i][2];
-        grb[i] = (g << 16) | (r << 8) | b;// Converte de RGB para GRB, invertendo a ordem dos bits para compatibilidade com a biblioteca ws2812.
-        // Envia a cor convertida para a ws2812, aplicando shift de 8 bits para o formato GRB.
-        pio_sm_put_blocking(pio, sm, grb[i] << 8u);
+        // Converte de RGB para GRB, aplicando shift de 8 bits para o formato esperado pela ws2812.
+        grb[i] = ((g << 16) | (r << 8) | b) << 8u;
+    }
+}
+// Envia as cores já convertidas para a ws2812
+static void HOT_FUNC(Leds_Send_grb)() {
+    for (int i = 0; i < LED_COUNT; i++) {
+        pio_sm_put_blocking(pio, sm, grb[i]);
     }
 }
 // Inicializa o controlador ws2812 para controlar LEDs
-void Leds_init(uint pin, int len_leds){
+void Leds_init(uint pin, int len_leds, bool clear){
     // Define a quantidade de LEDs que serão controlados
     LED_COUNT = len_leds;
     // Adiciona o programa ws2812 ao PIO e obtém o offset
@@ -35,13 +43,25 @@ void Leds_init(uint pin, int len_leds){
     ws2812_program_init(pio, sm, offset, pin, 800000, false);
     // Habilita o estado da máquina para começar a enviar dados
     pio_sm_set_enabled(pio, sm, true);
+    // DMA de 32 bits de grb para a FIFO da máquina de estados, no ritmo pedido pela PIO
+    DMA_CHAN = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(DMA_CHAN);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(DMA_CHAN, &config, &pio->txf[sm], grb, LED_COUNT, false);
+    // No boot a quente os LEDs mantêm as últimas cores e a limpeza é pulada
+    if (!clear) return;
     // Limpa o estado atual dos LEDs, apagando-os
     Leds_Clear_leds(true);
     // Aguarda um pequeno tempo para garantir que o estado seja atualizado
     sleep_us(100);
 }
-// Ativa LEDs específicos com cores específicas e converte as cores para o formato GRB
-void Leds_Map_leds_ON(uint8_t *LedsOn, uint8_t colorsOn[][3], int LedsOnCount, bool clear_cache){
+// Prepara as cores dos LEDs indicados sem enviá-las; o envio fica para Leds_Latch
+void Leds_Stage(const uint8_t *LedsOn, uint8_t colorsOn[][3], int LedsOnCount, bool clear_cache){
+    // Espera o DMA anterior terminar antes de reescrever o buffer que ele lê
+    dma_channel_wait_for_finish_blocking(DMA_CHAN);
     // Se o parâmetro clear_cache for true, limpa o estado atual dos LEDs
     if (clear_cache){
         Leds_Clear_leds(false);
@@ -53,14 +73,26 @@ void Leds_Map_leds_ON(uint8_t *LedsOn, uint8_t colorsOn[][3], int LedsOnCount, b
         colors[LedsOn[i]][1] = colorsOn[i][1]; // Componente verde
         colors[LedsOn[i]][2] = colorsOn[i][2]; // Componente azul
     }
-    // Converte as cores dos LEDs para o formato GRB e envia para o controlador de LEDs
+    // Converte as cores dos LEDs para o formato GRB, já no buffer lido pelo DMA
     Leds_rgb_to_grb(colors);
 }
+// Dispara o envio das cores preparadas por DMA e retorna na hora (os LEDs mudam ao fim do quadro, ~30 us por LED)
+void HOT_FUNC(Leds_Latch)(){
+    dma_channel_transfer_from_buffer_now(DMA_CHAN, grb, LED_COUNT);
+}
+// Ativa LEDs específicos com cores específicas e converte as cores para o formato GRB
+void Leds_Map_leds_ON(const uint8_t *LedsOn, uint8_t colorsOn[][3], int LedsOnCount, bool clear_cache){
+    Leds_Stage(LedsOn, colorsOn, LedsOnCount, clear_cache);
+    // Envia para o controlador de LEDs
+    Leds_Send_grb();
+}
 // Função para limpar o estado dos LEDs
 void Leds_Clear_leds(bool clear_all){
     // Zera todos os valores do array colors, apagando as cores dos LEDs com memset.  
     memset(colors, 0, sizeof(colors));
     if (clear_all){
+        dma_channel_wait_for_finish_blocking(DMA_CHAN); // Não reescreve grb durante um envio por DMA
         Leds_rgb_to_grb(colors);   // Limpa o estado atual dos LEDs, apagando-os
+        Leds_Send_grb();
     }
 }
@@ -1,53 +1,47 @@
+#include <string.h>
 #include "hardware/i2c.h"   // Biblioteca para comunicação I2C no Raspberry Pi Pico
 #include "headers/ssd1306.h"       // Biblioteca para controle do display OLED SSD1306
 #include "fonts/font6x7.h"     // Fonte personalizada de 6x7 pixels
 #include "headers/oled_local.h"           // Cabeçalho para funções de controle do OLED
-
-#define I2C_PORT i2c1       // Define a porta I2C usada (i2c1 no Raspberry Pi Pico)
-#define ADDR 0x3C           // Endereço I2C do display OLED (0x3C é o padrão para muitos OLEDs)
-
-// Dimensões do display OLED
-uint8_t WIDTH = 128;        // Largura do display em pixels (128 para OLEDs comuns)
-uint8_t HEIGHT = 64;        // Altura do display em pixels (64 para OLEDs comuns)
-
-static ssd1306_t ssd;       // Estrutura para armazenar configurações e estado do display
+#include "headers/oled_screens.h"         // Telas fixas pré-renderizadas em flash
+#include "headers/i2c_bus_local.h"        // Gerenciador do barramento I2C compartilhado
 
 // Definições de tamanho da fonte
-static uint8_t font_width = 6;   // Largura de cada caractere da fonte em pixels
-static uint8_t font_height = 7;  // Altura de cada caractere da fonte em pixels
+static const uint8_t font_width = 6;   // Largura de cada caractere da fonte em pixels
+static const uint8_t font_height = 7;  // Altura de cada caractere da fonte em pixels
 
 // Índices de início das diferentes categorias de caracteres na fonte
-static int FONT_START_0_9 = 16;   // Índice inicial para números (0-9) na fonte
-static int FONT_START_ABC = 33;   // Índice inicial para letras maiúsculas (A-Z) na fonte
-static int FONT_START_abc = 59;   // Índice inicial para letras minúsculas (a-z) na fonte
-
-// Inicializa o display OLED via I2C
-void oled_Init(uint pin_i2c_sda, uint pin_i2c_scl) {
-  i2c_init(I2C_PORT, 400 * 1000);  // Inicializa o I2C a 400 kHz (velocidade padrão para OLEDs)
-  gpio_set_function(pin_i2c_sda, GPIO_FUNC_I2C); // Define o pino SDA como função I2C
-  gpio_set_function(pin_i2c_scl, GPIO_FUNC_I2C); // Define o pino SCL como função I2C
-  gpio_pull_up(pin_i2c_sda); // Habilita resistor de pull-up no pino SDA
-  gpio_pull_up(pin_i2c_scl); // Habilita resistor de pull-up no pino SCL
-
-  ssd1306_init(&ssd, WIDTH, HEIGHT, false, ADDR, I2C_PORT); // Inicializa o display OLED com as configurações
-  ssd1306_config(&ssd);     // Configura o display (inicializa o buffer e outras configurações)
-  ssd1306_send_data(&ssd);  // Envia os dados iniciais para o display
-  oled_Clear();             // Limpa o display (apaga todos os pixels)
+static const int FONT_START_0_9 = 16;   // Índice inicial para números (0-9) na fonte
+static const int FONT_START_ABC = 33;   // Índice inicial para letras maiúsculas (A-Z) na fonte
+static const int FONT_START_abc = 59;   // Índice inicial para letras minúsculas (a-z) na fonte
+
+// Inicializa um display OLED no barramento e endereço indicados; cada handle tem seu próprio buffer e geometria.
+// Displays no mesmo barramento compartilham a tarefa do gerenciador; em barramentos diferentes atualizam em paralelo.
+// name aparece nas estatísticas do barramento (comando "i" do console).
+// configure=false (boot a quente): o SSD1306 mantém configuração e imagem, então só o I2C é reiniciado
+void oled_Init(oled_t *oled, const char *name, i2c_inst_t *i2c, uint pin_i2c_sda, uint pin_i2c_scl, uint8_t address, uint8_t width, uint8_t height, bool configure) {
+  i2c_bus_Init(i2c, pin_i2c_sda, pin_i2c_scl, 400 * 1000);  // Barramento a 400 kHz gerenciado por uma tarefa própria
+
+  ssd1306_init(oled, width, height, false, address, i2c, name); // Inicializa o display OLED com as configurações
+  if (!configure) return;
+  ssd1306_config(oled);     // Configura o display (inicializa o buffer e outras configurações)
+  ssd1306_send_data(oled);  // Envia os dados iniciais para o display
+  oled_Clear(oled);         // Limpa o display (apaga todos os pixels)
 }
 
 // Desenha uma matriz de pixels no display
-void oled_Draw_draw(uint8_t draw[], uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+void oled_Draw_draw(oled_t *oled, uint8_t draw[], uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
   for (uint8_t i = 0; i < height; i++) {  // Itera sobre cada linha da matriz de pixels
     uint8_t line = draw[i];  // Obtém a linha de pixels do caractere
     for (uint8_t j = 0; j < width; j++) {  // Itera sobre cada pixel da linha
       uint rotX = x + width - j; // Inverte a ordem dos bits para o desenho correto (da direita para a esquerda)
-      ssd1306_pixel(&ssd, rotX, y + i, line & (1 << j)); // Define o pixel no display (liga ou desliga)
+      ssd1306_pixel(oled, rotX, y + i, line & (1 << j)); // Define o pixel no display (liga ou desliga)
     }
   }
 }
 
 // Escreve um caractere no display
-void oled_Write_Char(char c, uint8_t x, uint8_t y) {
+void oled_Write_Char(oled_t *oled, char c, uint8_t x, uint8_t y) {
   uint16_t index = 0;  // Índice para acessar a fonte na memória
   if (c >= ' ' && c <= '/') index = (c - ' ') * font_height; // Caracteres especiais (espaço até '/')
   else if (c >= 'A' && c <= 'Z') index = (c - 'A' + FONT_START_ABC) * font_height; // Letras maiúsculas (A-Z)
@@ -58,49 +52,94 @@ void oled_Write_Char(char c, uint8_t x, uint8_t y) {
     uint8_t line = font[index + i];  // Obtém a linha do caractere da fonte
     for (uint8_t j = 0; j < font_width; j++) {  // Itera sobre cada pixel da linha
       uint rotX = x + (font_width - 1) - j; // Inverte a ordem dos bits (da direita para a esquerda)
-      ssd1306_pixel(&ssd, rotX, y + i, line & (1 << j)); // Define o pixel no display (liga ou desliga)
+      ssd1306_pixel(oled, rotX, y + i, line & (1 << j)); // Define o pixel no display (liga ou desliga)
     }
   }
 }
 
 // Escreve uma string de caracteres no display
-void oled_Write_String(const char *str, uint8_t x, uint8_t y) {
-  ssd1306_t *ssd_p = &ssd;  // Ponteiro para a estrutura do display
+void oled_Write_String(oled_t *oled, const char *str, uint8_t x, uint8_t y) {
   uint8_t spacing = font_width + 1; // Espaço entre caracteres (1 pixel de espaçamento)
 
   while (*str) {  // Itera sobre cada caractere da string até o final ('\0')
-    oled_Write_Char(*str++, x, y);  // Desenha o caractere atual e avança para o próximo
+    oled_Write_Char(oled, *str++, x, y);  // Desenha o caractere atual e avança para o próximo
     x += spacing;  // Move a posição horizontalmente para o próximo caractere
 
-    if (x + spacing >= ssd_p->width) {  // Se passar da largura do display
+    if (x + spacing >= oled->width) {  // Se passar da largura do display
       x = 0;  // Reseta a posição horizontal para o início
       y += font_height + 1;  // Move para a próxima linha
     }
-    if (y + font_height + 1 >= ssd_p->height) {  // Se ultrapassar a altura do display
+    if (y + font_height + 1 >= oled->height) {  // Se ultrapassar a altura do display
       break;  // Sai do loop (não desenha mais caracteres)
     }
   }
 }
 
 // Desenha um retângulo no display
-void oled_Draw_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool value, bool fill) {
-    ssd1306_rect(&ssd, x, y, width, height, value, fill); // Desenha um retângulo (sólido ou contorno)
+void oled_Draw_Rectangle(oled_t *oled, uint8_t x, uint8_t y, uint8_t width, uint8_t height, bool value, bool fill) {
+    ssd1306_rect(oled, x, y, width, height, value, fill); // Desenha um retângulo (sólido ou contorno)
 }
 
 // Desenha um retângulo em destaque (alterna entre preenchido e contorno)
-void oled_Bold_Rectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+void oled_Bold_Rectangle(oled_t *oled, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
   static bool fill = true;  // Variável para alternar entre preenchido e contorno
   fill = !fill;  // Inverte o estado (preenchido/contorno)
-  ssd1306_fill(&ssd, !fill); // Limpa o display (define todos os pixels como apagados ou ligados)
-  ssd1306_rect(&ssd, x, y, width, height, fill, !fill); // Desenha o retângulo com o estado atual
+  ssd1306_fill(oled, !fill); // Limpa o display (define todos os pixels como apagados ou ligados)
+  ssd1306_rect(oled, x, y, width, height, fill, !fill); // Desenha o retângulo com o estado atual
 }
 
-// Atualiza o display após alterações
-void oled_Update() {
-    ssd1306_send_data(&ssd); // Envia os dados do buffer para o display (atualiza a tela)
+// Mostra uma tela pré-renderizada em flash, se existir para a mensagem e posição pedidas.
+// Não desenha no ram_buffer: retorna false para que o chamador use o desenho normal (conteúdo dinâmico).
+bool oled_Show_Prerendered(oled_t *oled, const char *str, uint8_t x, uint8_t y) {
+  if (oled->width != OLED_SCREENS_WIDTH || oled->height != OLED_SCREENS_HEIGHT) return false;  // Imagens geradas para 128x64
+  ssd1306_wait(oled, I2C_BUS_WAIT_FOREVER);  // Não se mistura com uma atualização assíncrona em andamento
+  for (size_t i = 0; i < OLED_SCREENS_COUNT; i++) {
+    const oled_screen_t *screen = &OLED_SCREENS[i];
+    if (screen->x != x || screen->y != y || strcmp(screen->text, str) != 0) continue;
+    if (screen->rle) ssd1306_send_rle(oled, screen->data, screen->len);
+    else ssd1306_send_image(oled, screen->data, screen->len);
+    return true;
+  }
+  return false;
+}
+
+// Atualiza o display após alterações (espera o envio terminar)
+void oled_Update(oled_t *oled) {
+    ssd1306_send_data(oled); // Envia os dados do buffer para o display (atualiza a tela)
+}
+
+// Inicia a atualização sem esperar; o buffer não deve ser alterado até oled_Update_Wait
+void oled_Update_Async(oled_t *oled) {
+    ssd1306_send_data_async(oled);
+}
+
+// Espera a atualização assíncrona do display; retorna o resultado do envio ou PICO_ERROR_TIMEOUT
+int oled_Update_Wait(oled_t *oled, uint32_t timeout_ms) {
+    return ssd1306_wait(oled, timeout_ms);
+}
+
+// Atualiza vários displays de uma vez: barramentos diferentes transmitem em paralelo e displays
+// no mesmo barramento entram um após o outro na fila do gerenciador. Retorna o tempo total em us.
+uint32_t oled_Update_All(oled_t *const oleds[], int count) {
+    uint32_t start = time_us_32();
+    for (int i = 0; i < count; i++) oled_Update_Async(oleds[i]);
+    for (int i = 0; i < count; i++) oled_Update_Wait(oleds[i], I2C_BUS_WAIT_FOREVER);
+    return time_us_32() - start;
+}
+
+// Prepara uma troca de imagem fora da vista: o painel é apagado e a próxima imagem pode ser enviada sem aparecer.
+// O SSD1306 de 64 linhas não tem RAM sobrando para um segundo quadro, então o painel apagado faz esse papel.
+void oled_Stage(oled_t *oled) {
+    ssd1306_wait(oled, I2C_BUS_WAIT_FOREVER);
+    ssd1306_display_on(oled, false);
+}
+
+// Mostra a imagem preparada religando o painel: um comando de 2 bytes, feito para o instante da troca
+void oled_Latch(oled_t *oled) {
+    ssd1306_display_on(oled, true);
 }
 
 // Limpa o display, apagando todos os pixels
-void oled_Clear() {
-    ssd1306_fill(&ssd, false); // Define todos os pixels como apagados (limpa a tela)
-}
\ No newline at end of file
+void oled_Clear(oled_t *oled) {
+    ssd1306_fill(oled, false); // Define todos os pixels como apagados (limpa a tela)
+}
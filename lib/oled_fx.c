@@ -0,0 +1,117 @@
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "headers/ssd1306.h"
+#include "headers/oled_local.h"
+#include "headers/oled_fx_local.h"
+
+#define FX_FADE_STEP_MS 20  // Intervalo entre passos do esmaecimento por contraste
+
+// Efeitos animados: o controlador faz o trabalho e o timer só envia alguns bytes de comando por passo
+typedef enum{
+    FX_NONE,
+    FX_INVERT_BLINK,    // Alterna cores normais/invertidas
+    FX_DISPLAY_BLINK,   // Alterna painel ligado/apagado
+    FX_FADE             // Varia o contraste até o valor final
+} FxMode;
+
+static TimerHandle_t FX_TIMER = NULL;
+static volatile FxMode FX_MODE = FX_NONE;
+static bool FX_TOGGLE = false;
+static int FX_CONTRAST = 0xFF, FX_CONTRAST_END = 0xFF, FX_CONTRAST_STEP = 0;
+static oled_t *FX_TARGET = NULL;                        // Display animado pelo timer (um por vez)
+static i2c_bus_tx_t FX_TX;                              // Transação assíncrona usada pelo timer
+static uint8_t FX_BUFFER[2 * SSD1306_MAX_COMMANDS];
+
+// Passo do efeito, executado na tarefa de timers do FreeRTOS; nunca espera o barramento
+static void oled_Fx_Callback(TimerHandle_t timer){
+    uint8_t commands[2];
+    uint8_t count = 1;
+    switch(FX_MODE){
+        case FX_INVERT_BLINK:
+            commands[0] = SET_NORM_INV | !FX_TOGGLE;
+            break;
+        case FX_DISPLAY_BLINK:
+            commands[0] = SET_DISP | FX_TOGGLE;
+            break;
+        case FX_FADE:{
+            int next = FX_CONTRAST + FX_CONTRAST_STEP;
+            bool last = (FX_CONTRAST_STEP > 0 && next >= FX_CONTRAST_END) || (FX_CONTRAST_STEP <= 0 && next <= FX_CONTRAST_END);
+            if(last)next = FX_CONTRAST_END;
+            commands[0] = SET_CONTRAST;
+            commands[1] = next;
+            count = 2;
+            if(!ssd1306_command_async(FX_TARGET, &FX_TX, FX_BUFFER, commands, count))return;  // Repete no próximo tick
+            FX_CONTRAST = next;
+            if(last)xTimerStop(timer, 0);  // Só para depois que o valor final foi enviado
+            return;
+        }
+        default:
+            xTimerStop(timer, 0);
+            return;
+    }
+    // Se o passo anterior ainda está no barramento, este é pulado e o estado não muda
+    if(ssd1306_command_async(FX_TARGET, &FX_TX, FX_BUFFER, commands, count))FX_TOGGLE = !FX_TOGGLE;
+}
+// Para o timer e devolve a tela ao estado normal (cores normais, painel ligado, contraste máximo)
+static void oled_Fx_Stop_Timer(){
+    if(FX_MODE == FX_NONE)return;
+    if(FX_TIMER)xTimerStop(FX_TIMER, portMAX_DELAY);
+    FX_MODE = FX_NONE;
+    while(FX_TX.waiter && !FX_TX.done)vTaskDelay(1);  // Espera o último passo assíncrono
+    const uint8_t commands[4] = {SET_NORM_INV, SET_DISP | 0x01, SET_CONTRAST, 0xFF};
+    ssd1306_command_list(FX_TARGET, commands, sizeof(commands));
+    FX_CONTRAST = 0xFF;
+}
+// Para o timer antes de o estado compartilhado ser reescrito. A tarefa de timers tem prioridade máxima, então
+// ao retornar nenhum passo está em andamento. Um efeito em outro display é encerrado e esse display volta ao normal.
+static void oled_Fx_Take(oled_t *oled){
+    if(FX_TIMER)xTimerStop(FX_TIMER, portMAX_DELAY);
+    if(FX_TARGET != oled && FX_MODE != FX_NONE)oled_Fx_Stop_Timer();
+    FX_TARGET = oled;
+}
+// (Re)inicia o timer do efeito com o período indicado; o chamador já fez oled_Fx_Take
+static void oled_Fx_Start(FxMode mode, uint32_t period_ms){
+    if(!FX_TIMER)FX_TIMER = xTimerCreate("oled Fx", pdMS_TO_TICKS(period_ms), pdTRUE, NULL, oled_Fx_Callback);
+    FX_MODE = mode;
+    FX_TOGGLE = false;
+    xTimerChangePeriod(FX_TIMER, pdMS_TO_TICKS(period_ms), portMAX_DELAY);  // Também inicia o timer
+}
+// Rolagem horizontal contínua da tela inteira; speed de 0 a 7 (código de intervalo de quadros do SSD1306)
+void oled_Fx_Scroll(oled_t *oled, bool left, uint8_t speed){
+    ssd1306_scroll_h(oled, left, 0, oled->pages - 1, speed);
+}
+// Rolagem diagonal contínua; vertical_offset em linhas por passo
+void oled_Fx_Scroll_Diagonal(oled_t *oled, bool left, uint8_t speed, uint8_t vertical_offset){
+    ssd1306_scroll_diag(oled, left, 0, oled->pages - 1, speed, vertical_offset);
+}
+// Pisca a tela invertendo as cores a cada period_ms
+void oled_Fx_Blink_Invert(oled_t *oled, uint32_t period_ms){
+    oled_Fx_Take(oled);
+    oled_Fx_Start(FX_INVERT_BLINK, period_ms);
+}
+// Pisca a tela apagando e ligando o painel a cada period_ms (a imagem é mantida na RAM do display)
+void oled_Fx_Blink_Display(oled_t *oled, uint32_t period_ms){
+    oled_Fx_Take(oled);
+    oled_Fx_Start(FX_DISPLAY_BLINK, period_ms);
+}
+// Varia o contraste de from até to em duration_ms
+void oled_Fx_Fade(oled_t *oled, uint8_t from, uint8_t to, uint32_t duration_ms){
+    int steps = duration_ms / FX_FADE_STEP_MS;
+    if(steps < 1)steps = 1;
+    oled_Fx_Take(oled);  // O timer do efeito anterior não pode ler o contraste pela metade
+    FX_CONTRAST = from;
+    FX_CONTRAST_END = to;
+    FX_CONTRAST_STEP = ((int)to - (int)from) / steps;
+    if(FX_CONTRAST_STEP == 0)FX_CONTRAST_STEP = to > from ? 1 : -1;
+    ssd1306_contrast(oled, from);
+    oled_Fx_Start(FX_FADE, FX_FADE_STEP_MS);
+}
+// Encerra os efeitos do display. Retorna true se havia rolagem: a imagem precisa ser redesenhada pelo chamador.
+bool oled_Fx_Stop(oled_t *oled){
+    bool was_scrolling = oled->scrolling;
+    if(oled->scrolling)ssd1306_scroll_stop(oled);
+    if(FX_TARGET == oled)oled_Fx_Stop_Timer();
+    return was_scrolling;
+}
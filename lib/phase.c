@@ -0,0 +1,47 @@
+#include "pico/stdlib.h"
+#include "headers/phase_local.h"
+
+// Fases do ciclo: 0 = verde, 1 = amarelo, 2 = vermelho
+
+static phase_stats_t STATS = {0};
+static uint64_t LAST_START_US = 0;   // Início da fase anterior
+static uint32_t EXPECTED_US = 0;     // Duração prevista da fase anterior
+
+// Próxima fase do ciclo (1,2,0,1,2...)
+int phase_Next(int phase){
+    return (phase + 1) % 3;
+}
+// Duração da fase em ms: amarelo usa timers[1]; verde/vermelho usam timers[0], ou timers[2] no modo noturno
+int phase_Duration(int phase, bool night_mode, const int timers[3]){
+    return (phase == 1) ? timers[1] : (night_mode ? timers[2] : timers[0]);
+}
+// Índice de cor da matriz de LEDs: no modo noturno só o amarelo acende (3 = apagado)
+int phase_Leds_Index(int phase, bool night_mode){
+    return night_mode ? (phase != 1 ? 3 : phase) : phase;
+}
+// Índice de alerta (buzzer e display): no modo noturno sempre "Atencao"
+int phase_Alert_Index(int phase, bool night_mode){
+    return night_mode ? 1 : phase;
+}
+// Registra o início de uma fase com duração prevista expected_ms e mede o desvio da troca anterior
+void phase_Mark_Start(int expected_ms){
+    uint64_t now = to_us_since_boot(get_absolute_time());
+    if(LAST_START_US){
+        uint32_t real = now - LAST_START_US;
+        STATS.last_us = real > EXPECTED_US ? real - EXPECTED_US : EXPECTED_US - real;
+        if(STATS.last_us > STATS.max_us)STATS.max_us = STATS.last_us;
+        STATS.count++;
+    }
+    LAST_START_US = now;
+    EXPECTED_US = expected_ms * 1000;
+}
+// Retorna uma cópia das estatísticas de pontualidade
+phase_stats_t phase_Get_Stats(){
+    return STATS;
+}
+// Zera as estatísticas (o desvio da próxima troca volta a ser medido normalmente)
+void phase_Reset_Stats(){
+    STATS.count = 0;
+    STATS.last_us = 0;
+    STATS.max_us = 0;
+}
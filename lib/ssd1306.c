@@ -1,7 +1,8 @@
 #include "headers/ssd1306.h"
+#include "headers/hot_path.h"
 
-// Função de inicialização do display SSD1306
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+// Função de inicialização do display SSD1306; name identifica o display nas estatísticas do barramento
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, const char *name) {
   ssd->width = width;  // Define a largura do display
   ssd->height = height;  // Define a altura do display
   ssd->pages = height / 8U;  // Calcula o número de páginas (a altura dividida por 8, pois o display usa 8 bits por linha)
@@ -11,6 +12,9 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));  // Aloca memória para o buffer do display
   ssd->ram_buffer[0] = 0x40;  // Configura o primeiro byte do buffer para dados
   ssd->port_buffer[0] = 0x80;  // Configura o primeiro byte do buffer da porta para comandos
+  ssd->client = i2c_bus_Register_Client(name);  // Registra o display no gerenciador do barramento
+  ssd->window_tx.done = true;  // Nenhuma atualização assíncrona em andamento
+  ssd->data_tx.done = true;
 }
 // Função de configuração do display SSD1306
 void ssd1306_config(ssd1306_t *ssd) {
@@ -21,12 +25,12 @@ void ssd1306_config(ssd1306_t *ssd) {
   ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);  // Define a linha de início do display
   ssd1306_command(ssd, SET_SEG_REMAP | 0x01);  // Inverte a direção do mapeamento de segmentos
   ssd1306_command(ssd, SET_MUX_RATIO);  // Define a razão de multiplexação
-  ssd1306_command(ssd, HEIGHT - 1);  // Define a altura do display
+  ssd1306_command(ssd, ssd->height - 1);  // Define a altura do display
   ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);  // Define a direção das linhas de controle
   ssd1306_command(ssd, SET_DISP_OFFSET);  // Define o deslocamento do display
   ssd1306_command(ssd, 0x00);  // Define o deslocamento para 0
   ssd1306_command(ssd, SET_COM_PIN_CFG);  // Configura os pinos de controle
-  ssd1306_command(ssd, 0x12);  // Configuração adicional dos pinos
+  ssd1306_command(ssd, ssd->height == 64 ? 0x12 : 0x02);  // Configuração adicional dos pinos (alternada para 64 linhas, sequencial para 32)
   ssd1306_command(ssd, SET_DISP_CLK_DIV);  // Define a divisão do clock
   ssd1306_command(ssd, 0x80);  // Configuração do clock
   ssd1306_command(ssd, SET_PRECHARGE);  // Define o tempo de pré-carga
@@ -44,33 +48,101 @@ void ssd1306_config(ssd1306_t *ssd) {
 // Função para enviar comandos ao display SSD1306
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;  // Coloca o comando no buffer de dados
-  i2c_write_blocking(  // Envia o comando via I2C
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+  // Comandos são urgentes e agrupáveis: pares (0x80, comando) concatenados continuam válidos para o SSD1306
+  i2c_bus_Write(ssd->i2c_port, ssd->client, ssd->address, ssd->port_buffer, 2, I2C_BUS_URGENT, true, false);
+}
+// Monta os comandos no formato (0x80, comando) usado por ssd1306_command; retorna o tamanho montado
+static size_t ssd1306_pack_commands(uint8_t *buffer, const uint8_t *commands, uint8_t count) {
+  if (count > SSD1306_MAX_COMMANDS) count = SSD1306_MAX_COMMANDS;
+  for (uint8_t i = 0; i < count; i++) {
+    buffer[2 * i] = 0x80;  // Byte de controle: segue um comando e depois outro byte de controle
+    buffer[2 * i + 1] = commands[i];
+  }
+  return 2 * count;
+}
+// Função para enviar vários comandos em uma única transação
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, uint8_t count) {
+  uint8_t buffer[2 * SSD1306_MAX_COMMANDS];
+  size_t len = ssd1306_pack_commands(buffer, commands, count);
+  i2c_bus_Write(ssd->i2c_port, ssd->client, ssd->address, buffer, len, I2C_BUS_URGENT, true, false);
+}
+// Função para enviar vários comandos sem esperar nem bloquear (ex.: de callbacks de timers).
+// tx e buffer (2 * SSD1306_MAX_COMMANDS bytes) são do chamador; retorna false se o envio anterior ainda não terminou
+// ou se a fila do barramento está cheia (nesse caso tx fica concluída com erro e pode ser reutilizada).
+bool ssd1306_command_async(ssd1306_t *ssd, i2c_bus_tx_t *tx, uint8_t *buffer, const uint8_t *commands, uint8_t count) {
+  if (tx->waiter && !tx->done) return false;
+  tx->addr = ssd->address;
+  tx->data = buffer;
+  tx->len = ssd1306_pack_commands(buffer, commands, count);
+  tx->priority = I2C_BUS_URGENT;
+  tx->mergeable = true;
+  tx->split = false;
+  tx->client = ssd->client;
+  return i2c_bus_Try_Submit(ssd->i2c_port, tx);
+}
+// Função para definir a janela de escrita como a tela inteira
+static void ssd1306_set_window(ssd1306_t *ssd) {
+  const uint8_t commands[6] = {
+    SET_COL_ADDR, 0, ssd->width - 1,  // Colunas inicial e final
+    SET_PAGE_ADDR, 0, ssd->pages - 1  // Páginas inicial e final
+  };
+  ssd1306_command_list(ssd, commands, sizeof(commands));  // Os seis comandos vão em uma única transação
 }
 // Função para enviar dados (buffer) ao display SSD1306
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);  // Define o endereço da coluna
-  ssd1306_command(ssd, 0);  // Endereço inicial da coluna
-  ssd1306_command(ssd, ssd->width - 1);  // Endereço final da coluna
-  ssd1306_command(ssd, SET_PAGE_ADDR);  // Define o endereço da página
-  ssd1306_command(ssd, 0);  // Página inicial
-  ssd1306_command(ssd, ssd->pages - 1);  // Página final
-  i2c_write_blocking(  // Envia os dados do buffer ao display
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  ssd1306_send_data_async(ssd);
+  ssd1306_wait(ssd, I2C_BUS_WAIT_FOREVER);
+}
+// Função para iniciar o envio do buffer sem esperar; o buffer não pode mudar até ssd1306_wait.
+// Retorna false se a fila do barramento estava cheia: as transações ficam concluídas com erro.
+bool ssd1306_send_data_async(ssd1306_t *ssd) {
+  const uint8_t commands[6] = {SET_COL_ADDR, 0, ssd->width - 1, SET_PAGE_ADDR, 0, ssd->pages - 1};
+  ssd1306_wait(ssd, I2C_BUS_WAIT_FOREVER);  // Uma atualização por vez em cada display
+  // Janela e quadro vão na mesma fila (normal), então a janela sempre chega antes dos dados
+  ssd->window_tx = (i2c_bus_tx_t){.addr = ssd->address, .data = ssd->window_buffer,
+    .len = ssd1306_pack_commands(ssd->window_buffer, commands, sizeof(commands)),
+    .priority = I2C_BUS_NORMAL, .client = ssd->client};
+  // O quadro vai em fatias para não segurar as transações urgentes de outros dispositivos
+  ssd->data_tx = (i2c_bus_tx_t){.addr = ssd->address, .data = ssd->ram_buffer, .len = ssd->bufsize,
+    .priority = I2C_BUS_NORMAL, .split = true, .client = ssd->client};
+  if (!i2c_bus_Submit(ssd->i2c_port, &ssd->window_tx)) {
+    ssd->data_tx.result = ssd->window_tx.result;  // Sem a janela o quadro não é enviado
+    ssd->data_tx.done = true;
+    return false;
+  }
+  return i2c_bus_Submit(ssd->i2c_port, &ssd->data_tx);
+}
+// Função para esperar o envio assíncrono do buffer; retorna o resultado do envio ou PICO_ERROR_TIMEOUT
+int ssd1306_wait(ssd1306_t *ssd, uint32_t timeout_ms) {
+  int result = i2c_bus_Wait(&ssd->window_tx, timeout_ms);
+  if (result < 0) return result;
+  return i2c_bus_Wait(&ssd->data_tx, timeout_ms);
+}
+// Função para enviar uma imagem completa (já com o byte 0x40 inicial) direto da flash, sem passar pelo ram_buffer
+void ssd1306_send_image(ssd1306_t *ssd, const uint8_t *image, size_t len) {
+  ssd1306_set_window(ssd);  // Define a janela como a tela inteira
+  i2c_bus_Write(ssd->i2c_port, ssd->client, ssd->address, image, len, I2C_BUS_NORMAL, false, true);  // Fatias lidas diretamente da flash (XIP)
+}
+// Função para enviar uma imagem comprimida em RLE (pares quantidade, valor) direto da flash
+void ssd1306_send_rle(ssd1306_t *ssd, const uint8_t *rle, size_t len) {
+  uint8_t chunk[SSD1306_RLE_CHUNK + 1];  // Pequeno bloco na pilha, não usa o ram_buffer
+  size_t n = 0;
+  chunk[0] = 0x40;  // Byte de controle para dados
+  ssd1306_set_window(ssd);  // Define a janela como a tela inteira
+  for (size_t i = 0; i + 1 < len; i += 2) {
+    for (uint8_t run = rle[i]; run > 0; run--) {
+      chunk[++n] = rle[i + 1];
+      if (n == SSD1306_RLE_CHUNK) {  // O ponteiro de endereço do display continua entre transações
+        i2c_bus_Write(ssd->i2c_port, ssd->client, ssd->address, chunk, n + 1, I2C_BUS_NORMAL, false, false);
+        n = 0;
+      }
+    }
+  }
+  if (n > 0) i2c_bus_Write(ssd->i2c_port, ssd->client, ssd->address, chunk, n + 1, I2C_BUS_NORMAL, false, false);
 }
 // Função para desenhar um pixel no display
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;  // Calcula o índice no buffer de RAM
+void HOT_FUNC(ssd1306_pixel)(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  uint16_t index = (y >> 3) + x * ssd->pages + 1;  // Calcula o índice no buffer de RAM (endereçamento vertical)
   uint8_t pixel = (y & 0b111);  // Calcula a posição do pixel dentro do byte
   if (value)ssd->ram_buffer[index] |= (1 << pixel);// Se o valor for verdadeiro, acende o pixel
   else ssd->ram_buffer[index] &= ~(1 << pixel);// Se o valor for falso, apaga o pixel
@@ -135,4 +207,48 @@ void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
   // Desenha cada pixel na linha vertical
   for (uint8_t y = y0; y <= y1; ++y)ssd1306_pixel(ssd, x, y, value);
-}
\ No newline at end of file
+}
+// Função para iniciar a rolagem horizontal contínua entre as páginas indicadas (interval: 0 a 7, código de quadros do SSD1306)
+void ssd1306_scroll_h(ssd1306_t *ssd, bool left, uint8_t start_page, uint8_t end_page, uint8_t interval) {
+  const uint8_t commands[9] = {
+    SET_SCROLL_OFF,  // A rolagem precisa estar desativada antes de ser reconfigurada
+    SET_HSCROLL | left, 0x00, start_page, interval & 0x07, end_page, 0x00, 0xFF,
+    SET_SCROLL_ON
+  };
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+  ssd->scrolling = true;
+}
+// Função para iniciar a rolagem diagonal (vertical + horizontal) contínua
+void ssd1306_scroll_diag(ssd1306_t *ssd, bool left, uint8_t start_page, uint8_t end_page, uint8_t interval, uint8_t vertical_offset) {
+  const uint8_t commands[11] = {
+    SET_SCROLL_OFF,
+    SET_VSCROLL_AREA, 0, ssd->height,  // Toda a altura participa da rolagem vertical
+    SET_VHSCROLL + left, 0x00, start_page, interval & 0x07, end_page, vertical_offset & 0x3F,
+    SET_SCROLL_ON
+  };
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+  ssd->scrolling = true;
+}
+// Função para parar a rolagem; o conteúdo da RAM do display deve ser reenviado em seguida
+void ssd1306_scroll_stop(ssd1306_t *ssd) {
+  ssd1306_command(ssd, SET_SCROLL_OFF);
+  ssd->scrolling = false;
+}
+// Função para definir o contraste (0 a 255)
+void ssd1306_contrast(ssd1306_t *ssd, uint8_t value) {
+  const uint8_t commands[2] = {SET_CONTRAST, value};
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+}
+// Função para inverter (ou não) as cores da tela
+void ssd1306_invert(ssd1306_t *ssd, bool invert) {
+  ssd1306_command(ssd, SET_NORM_INV | invert);
+}
+// Função para ligar ou apagar o painel; a RAM do display é mantida
+void ssd1306_display_on(ssd1306_t *ssd, bool on) {
+  ssd1306_command(ssd, SET_DISP | on);
+}
+// Função para o esmaecimento do controlador: mode 0 desliga, 2 esmaece uma vez, 3 pisca continuamente; interval de 0 a 15
+void ssd1306_fade(ssd1306_t *ssd, uint8_t mode, uint8_t interval) {
+  const uint8_t commands[2] = {SET_FADE, ((mode & 0x03) << 4) | (interval & 0x0F)};
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+}
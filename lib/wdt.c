@@ -0,0 +1,130 @@
+#include "pico/stdlib.h"
+#include "hardware/watchdog.h"
+#include "hardware/structs/timer.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "headers/wdt_local.h"
+#include "headers/hot_path.h"
+
+// Registradores de rascunho do watchdog sobrevivem ao reset (4 a 7 são usados pelo bootrom)
+#define SCRATCH_MAGIC 0
+#define SCRATCH_STATE 1
+#define SCRATCH_ELAPSED 2
+#define SCRATCH_HUNG 3          // Bits 0-7: tarefa travada (0xFF nenhuma); 8-31: ms do último check-in dela até o reset
+#define HUNG_NONE 0xFFFFFFFFu
+#define WDT_MAGIC 0x5E3AF0A0u   // Marca de estado válido salvo nos registradores de rascunho
+#define WDT_PERIOD_MS 50        // Período em que o supervisor verifica as tarefas e alimenta o watchdog
+
+// Estrutura de cada tarefa supervisionada
+typedef struct{
+    const char *name;           // Nome da tarefa (para diagnóstico)
+    uint32_t deadline_us;       // Tempo máximo entre dois check-ins
+    volatile uint32_t last_us;  // Momento do último check-in
+} WdtTask;
+
+static WdtTask TASKS[WDT_MAX_TASKS];
+static int TASK_COUNT = 0;
+static uint32_t TIMEOUT_MS = 0;
+static volatile uint32_t PHASE_START_US = 0;  // Início da fase atual, para salvar o tempo decorrido
+static uint32_t LAST_FEED_US = 0;             // Última alimentação do watchdog (o reset vem TIMEOUT_MS depois)
+static bool WARM = false;                     // wdt_Warm_Boot encontrou estado válido
+static wdt_recovery_t RECOVERY = {0};         // Último boot a quente, consultado depois pelo console
+
+// Tempo em us lido direto do timer (sem código na flash, pode ser chamado de ISR); as diferenças
+// continuam válidas na volta do contador de 32 bits, pois prazos e fases duram bem menos de 71 min
+static uint32_t HOT_FUNC(wdt_Now_us)(){
+    return timer_hw->timerawl;
+}
+// Tarefa supervisora: só alimenta o watchdog enquanto todas as tarefas fizerem check-in no prazo
+static void wdt_Supervisor_Task(){
+    watchdog_enable(TIMEOUT_MS, true);  // Pausa durante a depuração
+    LAST_FEED_US = wdt_Now_us();
+    while(true){
+        uint32_t now = wdt_Now_us();
+        int hung = -1;
+        for(int i = 0; i < TASK_COUNT; i++){
+            if(now - TASKS[i].last_us > TASKS[i].deadline_us){
+                hung = i;
+                break;
+            }
+        }
+        watchdog_hw->scratch[SCRATCH_ELAPSED] = (now - PHASE_START_US) / 1000;  // Mantém atualizado o tempo dentro da fase
+        if(hung < 0){
+            watchdog_update();
+            LAST_FEED_US = now;
+        }else{
+            // Deixa o watchdog estourar e registra quem travou e quanto tempo vai do último check-in dela ao reset
+            int32_t to_reset_ms = (int32_t)(LAST_FEED_US - TASKS[hung].last_us) / 1000 + (int32_t)TIMEOUT_MS;
+            if(to_reset_ms < 0)to_reset_ms = 0;
+            watchdog_hw->scratch[SCRATCH_HUNG] = (uint32_t)hung | ((uint32_t)to_reset_ms << 8);
+        }
+        vTaskDelay(pdMS_TO_TICKS(WDT_PERIOD_MS));
+    }
+}
+// Cria a tarefa supervisora; o watchdog só é armado quando o escalonador começa
+void wdt_Init(uint32_t timeout_ms){
+    TIMEOUT_MS = timeout_ms;
+    // Os registradores de rascunho zeram na energização: sem isso a tarefa 0 levaria a culpa de um reset sem registro
+    if(!WARM)watchdog_hw->scratch[SCRATCH_HUNG] = HUNG_NONE;
+    xTaskCreate(wdt_Supervisor_Task, "wdt Supervisor_Task", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+2, NULL);
+}
+// Registra uma tarefa que deve fazer check-in pelo menos a cada deadline_ms; retorna o id ou -1
+int wdt_Register(const char *name, uint32_t deadline_ms){
+    if(TASK_COUNT >= WDT_MAX_TASKS)return -1;
+    TASKS[TASK_COUNT].name = name;
+    TASKS[TASK_COUNT].deadline_us = deadline_ms * 1000;
+    TASKS[TASK_COUNT].last_us = wdt_Now_us();
+    return TASK_COUNT++;
+}
+// Sinaliza que a tarefa está viva
+void wdt_Check_In(int id){
+    if(id >= 0 && id < TASK_COUNT)TASKS[id].last_us = wdt_Now_us();
+}
+// Salva fase e modo nos registradores de rascunho; reinicia a contagem de tempo se a fase mudou.
+// Pode ser chamada de ISR (apenas escritas em registradores).
+void HOT_FUNC(wdt_Save_State)(int phase, bool night_mode){
+    uint32_t state = (uint32_t)(phase & 0xFF) | (night_mode ? 0x100u : 0);
+    if((watchdog_hw->scratch[SCRATCH_STATE] & 0xFF) != (uint32_t)(phase & 0xFF) || watchdog_hw->scratch[SCRATCH_MAGIC] != WDT_MAGIC){
+        PHASE_START_US = wdt_Now_us();
+        watchdog_hw->scratch[SCRATCH_ELAPSED] = 0;
+    }
+    watchdog_hw->scratch[SCRATCH_STATE] = state;
+    watchdog_hw->scratch[SCRATCH_MAGIC] = WDT_MAGIC;
+}
+// Retorna true se o reset foi causado pelo watchdog e há estado salvo válido (caminho de boot a quente)
+bool wdt_Warm_Boot(int *phase, bool *night_mode, uint32_t *elapsed_ms){
+    if(!watchdog_enable_caused_reboot() || watchdog_hw->scratch[SCRATCH_MAGIC] != WDT_MAGIC)return false;
+    uint32_t state = watchdog_hw->scratch[SCRATCH_STATE];
+    *phase = state & 0xFF;
+    *night_mode = state & 0x100u;
+    *elapsed_ms = watchdog_hw->scratch[SCRATCH_ELAPSED];
+    PHASE_START_US = wdt_Now_us() - *elapsed_ms * 1000;  // Continua contando o tempo da fase de onde parou
+    WARM = *phase >= 0 && *phase < 3;
+    return WARM;
+}
+// Guarda qual tarefa travou e quanto tempo foi do travamento à retomada da fase (até o reset, medido pelo
+// supervisor; do reset à retomada, agora). Se o supervisor não registrou a tarefa, guarda o pior caso:
+// maior prazo de check-in + período do supervisor + timeout do watchdog.
+// Nesse momento a USB CDC ainda não enumerou, então o relato fica para o console (comando "s").
+void wdt_Record_Recovery(int phase){
+    uint32_t hung = watchdog_hw->scratch[SCRATCH_HUNG];
+    watchdog_hw->scratch[SCRATCH_HUNG] = HUNG_NONE;  // Não atribui o próximo reset a esta tarefa
+    RECOVERY.valid = true;
+    RECOVERY.phase = phase;
+    RECOVERY.resume_us = time_us_32();
+    RECOVERY.hung = (hung & 0xFF) < (uint32_t)TASK_COUNT ? (int)(hung & 0xFF) : -1;
+    RECOVERY.measured = RECOVERY.hung >= 0;
+    if(RECOVERY.measured){
+        RECOVERY.hang_to_reset_ms = hung >> 8;
+    }else{
+        uint32_t deadline_us = 0;
+        for(int i = 0; i < TASK_COUNT; i++)if(TASKS[i].deadline_us > deadline_us)deadline_us = TASKS[i].deadline_us;
+        RECOVERY.hang_to_reset_ms = deadline_us / 1000 + WDT_PERIOD_MS + TIMEOUT_MS;
+    }
+}
+// Copia o relato do último boot a quente; retorna false se o boot foi a frio
+bool wdt_Get_Recovery(wdt_recovery_t *recovery, const char **hung_name){
+    *recovery = RECOVERY;
+    *hung_name = RECOVERY.hung >= 0 ? TASKS[RECOVERY.hung].name : "?";
+    return RECOVERY.valid;
+}
@@ -8,11 +8,19 @@
 #include "FreeRTOSConfig.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "semphr.h"
 
 #include "lib/headers/leds_local.h"
 #include "lib/headers/oled_local.h"
+#include "lib/headers/oled_fx_local.h"
 #include "lib/headers/buzzer_local.h"
 #include "lib/headers/interrupt_local.h"
+#include "lib/headers/wdt_local.h"
+#include "lib/headers/phase_local.h"
+#include "lib/headers/hot_path.h"
+#include "lib/headers/console_local.h"
+#include "lib/headers/latch_local.h"
+#include "lib/headers/alert_msg.h"
 
 #define PIN_I2C_SDA 14
 #define PIN_I2C_SCL 15
@@ -20,18 +28,54 @@
 #define PIN_BT_B 6
 #define PIN_LEDS 7
 #define PIN_BUZZER 21
+#define OLED_ADDR 0x3C
+#ifndef OLED_MAINTENANCE
+#define OLED_MAINTENANCE 0 // Se 1, um segundo display no i2c0 (GPIO 0/1) mostra fase e tempo de atualização
+#endif
+#define PIN_I2C0_SDA 0
+#define PIN_I2C0_SCL 1
+#define WDT_TIMEOUT_MS 300
+#define WDT_SLICE_MS 100
+#define COMMIT_LEAD_MS 60 // Antecedência da preparação das saídas da próxima fase (limite do envio do OLED)
+#define OLED_STAGE_MARGIN_MS 2 // Folga sobre o último envio medido (arredondamento e granularidade do tick)
+#ifndef WDT_HANG_TEST
+#define WDT_HANG_TEST 0 // Se > 0, trava a tarefa do display após N trocas de fase (teste de recuperação)
+#endif
 bool NIGHT_MODE = false;
 int COUNT_COLOR = -1;
+bool WARM_BOOT = false;
+uint32_t RESUME_ELAPSED_MS = 0;
+int WDT_IDS[4];
+oled_t OLED_MAIN;
+#if OLED_MAINTENANCE
+oled_t OLED_MAINT;
+#endif
+uint32_t OLED_REFRESH_US = 0; // Tempo da última atualização dos displays
+uint32_t OLED_STAGE_US = COMMIT_LEAD_MS * 1000; // Último tempo de painel apagado na troca (desligar, desenhar e enviar)
+// Estado já aplicado a cada saída; as tarefas só corrigem o que mudou fora da troca de fase (ex.: modo noturno)
+typedef struct{
+    bool ready;     // A primeira troca de fase já aconteceu
+    int leds;       // Índice de cor da matriz
+    int beep;       // Índice do último alerta do buzzer
+    int screen;     // Índice do alerta no display
+    bool night;     // Efeito do modo noturno no display
+} applied_t;
+applied_t APPLIED = {false, -1, -1, -1, false};
+uint32_t LAST_BEEP_US = 0;
+SemaphoreHandle_t OUTPUT_LOCK; // Impede que as tarefas mexam nas saídas entre a preparação e o latch
 
-uint RGB_LED[2] = {11,13};
-uint8_t LEDS_ACTIVE[9] = {6,7,8,11,12,13,16,17,18};
+const uint RGB_LED[2] = {11,13};
+const uint8_t LEDS_ACTIVE[9] = {6,7,8,11,12,13,16,17,18};
 uint8_t COLORS_GYR[4][3] = {{0,10,0},{10,10,0},{10,0,0},{0,0,0}};
 int BUZZER_BEEPS[4][3] = {{3000,1000,5000},{2000,300,500},{1000,500,1500},{2000,300,2000}};
 int TIMERS[3] = {5000,3000,500};
-char *ALERT_MSG[3] = {"Pode Atravessar","Atencao","Pare"};
+const char *const ALERT_MSG[ALERT_MSG_COUNT] = ALERT_MSG_LIST;
 
 
 void Fill_Colors();
+void Apply_Console_Params();
+bool Draw_Alert(int index);
+void Commit_Phase(int next, TickType_t *wake, int lead_ms);
 void vTraffic_light_RGBTask1();
 void vTraffic_light_LedsTask2();
 void vTraffic_light_BuzzerTask3();
@@ -44,26 +88,58 @@ void setup_config(uint pin, bool output){
     gpio_put(pin,false);
 }
 // Trecho para modo BOOTSEL com botão B
-void gpio_irq_handler(uint gpio, uint32_t events){
+void HOT_FUNC(gpio_irq_handler)(uint gpio, uint32_t events){
     if(!gpio_get(PIN_BT_B))reset_usb_boot(0, 0);
-    if(!gpio_get(PIN_BT_A))NIGHT_MODE = !NIGHT_MODE;
+    if(!gpio_get(PIN_BT_A)){
+        NIGHT_MODE = !NIGHT_MODE;
+        wdt_Save_State(COUNT_COLOR, NIGHT_MODE);
+    }
+}
+// Espera ms a partir de *wake em fatias, fazendo check-in no watchdog a cada fatia sem acumular atraso
+void Task_Wait(int wdt_id, TickType_t *wake, int ms){
+    TickType_t remaining = pdMS_TO_TICKS(ms);
+    while(remaining > 0){
+        TickType_t step = remaining > pdMS_TO_TICKS(WDT_SLICE_MS) ? pdMS_TO_TICKS(WDT_SLICE_MS) : remaining;
+        vTaskDelayUntil(wake, step);
+        remaining -= step;
+        wdt_Check_In(wdt_id);
+    }
 }
 
 int main(){
     stdio_init_all();
+    int phase;
+    // Boot a quente: retoma fase, modo e tempo salvos pelo watchdog e pula a reinicialização dos periféricos externos
+    WARM_BOOT = wdt_Warm_Boot(&phase, &NIGHT_MODE, &RESUME_ELAPSED_MS);
+    if(WARM_BOOT)COUNT_COLOR = (phase + 2) % 3;// A tarefa RGB avança para a fase salva
     for(int i = 0; i < sizeof(RGB_LED)/sizeof(RGB_LED[0]); i++)setup_config(RGB_LED[i], GPIO_OUT);
-    Leds_init(PIN_LEDS,25);
+    Leds_init(PIN_LEDS,25,!WARM_BOOT);
     Fill_Colors();
-    oled_Init(PIN_I2C_SDA, PIN_I2C_SCL);
+    oled_Init(&OLED_MAIN, "oled principal", i2c1, PIN_I2C_SDA, PIN_I2C_SCL, OLED_ADDR, 128, 64, !WARM_BOOT);
+#if OLED_MAINTENANCE
+    oled_Init(&OLED_MAINT, "oled manutencao", i2c0, PIN_I2C0_SDA, PIN_I2C0_SCL, OLED_ADDR, 128, 32, !WARM_BOOT);
+#endif
     buzzer_init(PIN_BUZZER);
     itr_SetCallbackFunction(gpio_irq_handler);
     itr_Interruption(PIN_BT_A);
     itr_Interruption(PIN_BT_B);
-    
-    xTaskCreate(vTraffic_light_RGBTask1, "semaforo RGB_Task", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+1, NULL);
+
+    wdt_Init(WDT_TIMEOUT_MS);
+    WDT_IDS[0] = wdt_Register("RGB_Task", 2*WDT_SLICE_MS);
+    WDT_IDS[1] = wdt_Register("Leds_Task", 500);
+    WDT_IDS[2] = wdt_Register("Buzzer_Task", 500);
+    WDT_IDS[3] = wdt_Register("Display_Task", 500);
+
+    OUTPUT_LOCK = xSemaphoreCreateMutex();
+    console_params_t params;
+    memcpy(params.timers, TIMERS, sizeof(TIMERS));
+    memcpy(params.colors, COLORS_GYR, sizeof(COLORS_GYR));
+    memcpy(params.beeps, BUZZER_BEEPS, sizeof(BUZZER_BEEPS));
+    console_Init(&params);
+    xTaskCreate(vTraffic_light_RGBTask1, "semaforo RGB_Task", 2*configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+1, NULL);
     xTaskCreate(vTraffic_light_LedsTask2, "semaforo Leds_Task", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
     xTaskCreate(vTraffic_light_BuzzerTask3, "semaforo Buzzer_Task", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
-    xTaskCreate(vTraffic_light_DisplayTask4, "semaforo Display_Task", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
+    xTaskCreate(vTraffic_light_DisplayTask4, "semaforo Display_Task", 2*configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL);
     vTaskStartScheduler();
     panic_unsupported();
 }
@@ -71,59 +147,171 @@ uint8_t COLORS_TRAFFIC_LIGHT[4][9][3];
 void Fill_Colors(){
     for (int i = 0; i < 4; i++) {
         for (int j = 0; j < 9; j++) {
-            memcpy(COLORS_TRAFFIC_LIGHT[i][j], COLORS_GYR[i], 4);
+            memcpy(COLORS_TRAFFIC_LIGHT[i][j], COLORS_GYR[i], sizeof(COLORS_GYR[i]));
         }
     } 
 }
+// Aplica os parâmetros enviados pelo console; chamada apenas na troca de fase
+void Apply_Console_Params(){
+    console_params_t params;
+    if(!console_Take_Pending(&params))return;
+    xSemaphoreTake(OUTPUT_LOCK, portMAX_DELAY);// As tarefas das saídas leem estas tabelas com a trava
+    memcpy(TIMERS, params.timers, sizeof(TIMERS));
+    memcpy(COLORS_GYR, params.colors, sizeof(COLORS_GYR));
+    memcpy(BUZZER_BEEPS, params.beeps, sizeof(BUZZER_BEEPS));
+    Fill_Colors();
+    xSemaphoreGive(OUTPUT_LOCK);
+}
+// Desenha o alerta no display principal; retorna true se o buffer precisa ser enviado (sem tela pronta na flash)
+bool Draw_Alert(int index){
+    if(oled_Show_Prerendered(&OLED_MAIN, ALERT_MSG[index], ALERT_MSG_X, ALERT_MSG_Y))return false;// Telas fixas vêm prontas da flash
+    oled_Clear(&OLED_MAIN);
+    oled_Write_String(&OLED_MAIN, ALERT_MSG[index], ALERT_MSG_X, ALERT_MSG_Y);
+    return true;
+}
+// Troca de fase sincronizada: prepara as saídas da fase next, espera lead_ms a partir de *wake e aciona todas juntas.
+// O display vai primeiro por ser o único acionamento pelo I2C; os demais são escritas de registrador em seção crítica.
+// O painel só é apagado o mais perto possível do prazo, com a antecedência do último envio medido.
+void Commit_Phase(int next, TickType_t *wake, int lead_ms){
+    bool night = NIGHT_MODE;
+    int leds = phase_Leds_Index(next, night);
+    int alert = phase_Alert_Index(next, night);
+    uint32_t rgb_mask = 0, rgb_value = 0;
+    for (int i = 0; i < 3; i++) {
+        bool on = (i == next && !night) || next == 1;
+        uint32_t bit = 1u << RGB_LED[i == 2 ? 1 : i];
+        rgb_mask |= bit;
+        rgb_value = on ? rgb_value | bit : rgb_value & ~bit;
+    }
+    xSemaphoreTake(OUTPUT_LOCK, portMAX_DELAY);
+    bool beep = alert != APPLIED.beep;
+    bool screen = alert != APPLIED.screen;
+    Leds_Stage(LEDS_ACTIVE, COLORS_TRAFFIC_LIGHT[leds], 9, true);
+    if(beep)buzzer_Stage(BUZZER_BEEPS[alert][0], BUZZER_BEEPS[alert][1]);
+    if(screen){
+        int oled_lead = OLED_STAGE_US / 1000 + OLED_STAGE_MARGIN_MS;
+        if(oled_lead > lead_ms)oled_lead = lead_ms;
+        Task_Wait(WDT_IDS[0], wake, lead_ms - oled_lead);
+        uint32_t start = time_us_32();
+        oled_Stage(&OLED_MAIN);
+        if(Draw_Alert(alert))oled_Update(&OLED_MAIN);
+        OLED_STAGE_US = time_us_32() - start;
+        lead_ms = oled_lead;
+    }
+    Task_Wait(WDT_IDS[0], wake, lead_ms);// Se o envio passou do previsto, não espera e o prazo continua no mesmo ritmo
+    latch_Begin();
+    if(screen){
+        oled_Latch(&OLED_MAIN);
+        latch_Mark(LATCH_OLED);
+    }
+    taskENTER_CRITICAL();
+    Leds_Latch();
+    latch_Mark(LATCH_LEDS);
+    gpio_put_masked(rgb_mask, rgb_value);
+    latch_Mark(LATCH_RGB);
+    if(beep){
+        buzzer_Latch();
+        latch_Mark(LATCH_BUZZER);
+    }
+    taskEXIT_CRITICAL();
+    if(beep)buzzer_Schedule_Stop();// Agendar o alarme usa o pool de alarmes do SDK, fora da seção crítica
+    latch_End();
+    COUNT_COLOR = next;
+    APPLIED.ready = true;
+    APPLIED.leds = leds;
+    if(beep){
+        APPLIED.beep = alert;
+        LAST_BEEP_US = to_us_since_boot(get_absolute_time());
+    }
+    if(screen)APPLIED.screen = alert;
+    xSemaphoreGive(OUTPUT_LOCK);
+}
 void vTraffic_light_RGBTask1() {
+    TickType_t wake = xTaskGetTickCount();
+    int time = 0;// Restante da fase atual; a primeira troca é imediata
     while (true) {
-        COUNT_COLOR = (COUNT_COLOR + 1) % 3;//1,2,0,1,2(...)
-        int time = (COUNT_COLOR == 1) ? TIMERS[1] : (NIGHT_MODE ? TIMERS[2] : TIMERS[0]);
-        for (int i = 0; i < 3; i++) {
-            bool on = (i == COUNT_COLOR && !NIGHT_MODE) || COUNT_COLOR == 1;
-            gpio_put(RGB_LED[i == 2 ? 1 : i], on);
+        int lead = time < COMMIT_LEAD_MS ? time : COMMIT_LEAD_MS;
+        Task_Wait(WDT_IDS[0], &wake, time - lead);
+        Apply_Console_Params();
+        Commit_Phase(phase_Next(COUNT_COLOR), &wake, lead);//1,2,0,1,2(...)
+        wdt_Save_State(COUNT_COLOR, NIGHT_MODE);
+        time = phase_Duration(COUNT_COLOR, NIGHT_MODE, TIMERS);
+        time = (uint32_t)time > RESUME_ELAPSED_MS ? time - (int)RESUME_ELAPSED_MS : 0;// Após boot a quente, completa só o restante da fase
+        RESUME_ELAPSED_MS = 0;
+        phase_Mark_Start(time);
+        if(WARM_BOOT){
+            WARM_BOOT = false;
+            wdt_Record_Recovery(COUNT_COLOR);
         }
-        vTaskDelay(pdMS_TO_TICKS(time));
     }
 }
+// As tarefas abaixo só tratam mudanças fora da troca de fase, que já chega aplicada por Commit_Phase
 void vTraffic_light_LedsTask2(){
-    int last_index = -1;
     while(true){
-        int index = NIGHT_MODE?(COUNT_COLOR!=1?3:COUNT_COLOR):COUNT_COLOR;
         vTaskDelay(pdMS_TO_TICKS(10));
-        if(index != last_index){
+        wdt_Check_In(WDT_IDS[1]);
+        xSemaphoreTake(OUTPUT_LOCK, portMAX_DELAY);
+        int index = phase_Leds_Index(COUNT_COLOR, NIGHT_MODE);
+        if(APPLIED.ready && index != APPLIED.leds){
             Leds_Map_leds_ON(LEDS_ACTIVE, COLORS_TRAFFIC_LIGHT[index],9,true);
+            APPLIED.leds = index;
         }
+        xSemaphoreGive(OUTPUT_LOCK);
     }
 }
 
 void vTraffic_light_BuzzerTask3(){
-    int last_index = -1;
-    uint32_t last_time = 0;
     while (true){
-        int index = NIGHT_MODE?(COUNT_COLOR!=1?1:COUNT_COLOR):COUNT_COLOR;
         vTaskDelay(pdMS_TO_TICKS(10));
-        bool index_modified = index != last_index;
+        wdt_Check_In(WDT_IDS[2]);
+        xSemaphoreTake(OUTPUT_LOCK, portMAX_DELAY);
+        int index = phase_Alert_Index(COUNT_COLOR, NIGHT_MODE);
+        bool index_modified = index != APPLIED.beep;
         uint32_t current_time = to_us_since_boot(get_absolute_time()); // Obtém o tempo atual em microssegundos
-        bool valid_time = current_time-last_time>BUZZER_BEEPS[NIGHT_MODE?3:index][2]*1000; // Verifica se o tempo de debounce foi atingido
-        if(valid_time || index_modified){
-            last_index = index;
-            last_time = current_time;
-            buzzer_play_note(BUZZER_BEEPS[index][0],BUZZER_BEEPS[index][1]);
+        bool valid_time = current_time-LAST_BEEP_US>BUZZER_BEEPS[NIGHT_MODE?3:index][2]*1000; // Verifica se o tempo de debounce foi atingido
+        if(APPLIED.ready && (valid_time || index_modified)){
+            APPLIED.beep = index;
+            LAST_BEEP_US = current_time;
+            buzzer_play_note_async(BUZZER_BEEPS[index][0],BUZZER_BEEPS[index][1]);// Não bloqueia: o fim da nota é agendado por alarme
         }
+        xSemaphoreGive(OUTPUT_LOCK);
     }
 }
 
 void vTraffic_light_DisplayTask4(){
-    int last_index = -1;
+    int changes = 0;
+    int last_phase = -1;
+    oled_t *flush[2];
     while (true){
-        int index = NIGHT_MODE?(COUNT_COLOR!=1?1:COUNT_COLOR):COUNT_COLOR;
         vTaskDelay(pdMS_TO_TICKS(10));
-        if(index != last_index){
-            last_index = index;
-            oled_Clear();
-            oled_Write_String(ALERT_MSG[index], 2, 27);
-            oled_Update();
+        wdt_Check_In(WDT_IDS[3]);
+        bool phase_changed = COUNT_COLOR != last_phase;
+        last_phase = COUNT_COLOR;
+        if(phase_changed && WDT_HANG_TEST > 0 && ++changes == WDT_HANG_TEST)while(true)tight_loop_contents();// Simula uma tarefa travada
+        xSemaphoreTake(OUTPUT_LOCK, portMAX_DELAY);
+        int index = phase_Alert_Index(COUNT_COLOR, NIGHT_MODE);
+        int count = 0;
+        if(APPLIED.ready && (index != APPLIED.screen || NIGHT_MODE != APPLIED.night)){
+            APPLIED.screen = index;
+            APPLIED.night = NIGHT_MODE;
+            // No modo noturno o alerta pisca por inversão de cores no próprio controlador, sem reenviar a imagem
+            if(NIGHT_MODE)oled_Fx_Blink_Invert(&OLED_MAIN, TIMERS[2]);
+            else oled_Fx_Stop(&OLED_MAIN);
+            if(Draw_Alert(index))flush[count++] = &OLED_MAIN;
+        }
+#if OLED_MAINTENANCE
+        if(APPLIED.ready && phase_changed){
+            char line[24];
+            oled_Clear(&OLED_MAINT);
+            snprintf(line, sizeof(line), "Fase %d %s", COUNT_COLOR, NIGHT_MODE ? "Noite" : "Dia");
+            oled_Write_String(&OLED_MAINT, line, 2, 4);
+            snprintf(line, sizeof(line), "Oled %lu us", (unsigned long)OLED_REFRESH_US);
+            oled_Write_String(&OLED_MAINT, line, 2, 18);
+            flush[count++] = &OLED_MAINT;
         }
+#endif
+        // Displays em barramentos diferentes são enviados em paralelo pelas tarefas de cada barramento
+        if(count > 0)OLED_REFRESH_US = oled_Update_All(flush, count);
+        xSemaphoreGive(OUTPUT_LOCK);
     }
 }
\ No newline at end of file
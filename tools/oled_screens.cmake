@@ -0,0 +1,45 @@
+# Gera oled_screens.c no build: o gerador é compilado para o host (como o pioasm do pico_generate_pio_header)
+# e executado a partir de lib/headers/alert_msg.h, a mesma lista de mensagens que o firmware desenha.
+# Uso: include(tools/oled_screens.cmake) e semaforo_generate_oled_screens(<alvo>)
+set(OLED_SCREENS_TOOLS_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(OLED_SCREENS_ROOT ${CMAKE_CURRENT_LIST_DIR}/..)
+
+function(semaforo_generate_oled_screens TARGET)
+    if(CMAKE_CROSSCOMPILING)
+        # O compilador do projeto é o cruzado: o gerador vai num projeto separado, com o compilador do host
+        if(NOT TARGET oledScreensGenBuild)
+            include(ExternalProject)
+            set(GEN_BINARY_DIR ${CMAKE_BINARY_DIR}/oled_screens_gen)
+            ExternalProject_Add(oledScreensGenBuild
+                SOURCE_DIR ${OLED_SCREENS_TOOLS_DIR}
+                BINARY_DIR ${GEN_BINARY_DIR}
+                CMAKE_ARGS -DCMAKE_BUILD_TYPE=Release
+                BUILD_ALWAYS 1
+                INSTALL_COMMAND ""
+                BUILD_BYPRODUCTS ${GEN_BINARY_DIR}/oled_screens_gen${CMAKE_HOST_EXECUTABLE_SUFFIX}
+            )
+            set_property(GLOBAL PROPERTY OLED_SCREENS_GEN ${GEN_BINARY_DIR}/oled_screens_gen${CMAKE_HOST_EXECUTABLE_SUFFIX})
+        endif()
+        get_property(GEN GLOBAL PROPERTY OLED_SCREENS_GEN)
+        set(GEN_DEPENDS oledScreensGenBuild)
+    else()
+        # Build de host (bench): o próprio projeto compila o gerador
+        if(NOT TARGET oled_screens_gen)
+            add_executable(oled_screens_gen ${OLED_SCREENS_TOOLS_DIR}/oled_screens_gen.c)
+        endif()
+        set(GEN $<TARGET_FILE:oled_screens_gen>)
+        set(GEN_DEPENDS oled_screens_gen)
+    endif()
+    set(OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/generated/oled_screens.c)
+    add_custom_command(OUTPUT ${OUTPUT}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${CMAKE_CURRENT_BINARY_DIR}/generated
+        COMMAND ${GEN} -o ${OUTPUT}
+        DEPENDS ${GEN_DEPENDS}
+            ${OLED_SCREENS_TOOLS_DIR}/oled_screens_gen.c
+            ${OLED_SCREENS_ROOT}/lib/headers/alert_msg.h
+            ${OLED_SCREENS_ROOT}/lib/fonts/font6x7.h
+        COMMENT "Gerando as telas pré-renderizadas do OLED"
+        VERBATIM
+    )
+    target_sources(${TARGET} PRIVATE ${OUTPUT})
+endfunction()
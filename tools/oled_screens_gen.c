@@ -0,0 +1,151 @@
+// Gerador (host) das telas fixas do OLED pré-renderizadas em flash.
+// Rasteriza cada mensagem com a mesma lógica de lib/oled.c (fonte 6x7, endereçamento vertical)
+// e emite oled_screens.c com as imagens const prontas para serem enviadas ao SSD1306.
+// O build compila e executa este gerador no host (tools/oled_screens.cmake); sem textos na linha de comando
+// ele usa as mensagens de lib/headers/alert_msg.h, as mesmas que o firmware desenha.
+// Por padrão as imagens são brutas: vão da flash ao barramento em poucas fatias, sem trabalho da CPU.
+// Com -rle PCT, uma tela passa a RLE quando fica com no máximo PCT% do tamanho bruto; economiza flash,
+// mas é descomprimida pela CPU e enviada em muitas transações pequenas.
+//
+// Uso: oled_screens_gen [-o arquivo] [-rle PCT] [-x X -y Y "texto" ...]
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../lib/fonts/font6x7.h"
+#include "../lib/headers/alert_msg.h"
+
+#define WIDTH 128
+#define HEIGHT 64
+#define PAGES (HEIGHT / 8)
+#define BUFSIZE (PAGES * WIDTH + 1)
+
+static const uint8_t font_width = 6;
+static const uint8_t font_height = 7;
+static const int FONT_START_0_9 = 16;
+static const int FONT_START_ABC = 33;
+static const int FONT_START_abc = 59;
+
+static uint8_t buffer[BUFSIZE];
+
+// Mesma fórmula de ssd1306_pixel (modo de endereçamento vertical)
+static void pixel(uint8_t x, uint8_t y, bool value) {
+  uint16_t index = (y >> 3) + (x << 3) + 1;
+  uint8_t bit = (y & 0b111);
+  if (value) buffer[index] |= (1 << bit);
+  else buffer[index] &= ~(1 << bit);
+}
+
+// Mesma lógica de oled_Write_Char
+static void write_char(char c, uint8_t x, uint8_t y) {
+  uint16_t index = 0;
+  if (c >= ' ' && c <= '/') index = (c - ' ') * font_height;
+  else if (c >= 'A' && c <= 'Z') index = (c - 'A' + FONT_START_ABC) * font_height;
+  else if (c >= 'a' && c <= 'z') index = (c - 'a' + FONT_START_abc) * font_height;
+  else if (c >= '0' && c <= '@') index = (c - '0' + FONT_START_0_9) * font_height;
+
+  for (uint8_t i = 0; i < font_height; i++) {
+    uint8_t line = font[index + i];
+    for (uint8_t j = 0; j < font_width; j++) {
+      pixel(x + (font_width - 1) - j, y + i, line & (1 << j));
+    }
+  }
+}
+
+// Mesma lógica de oled_Write_String (quebra de linha e corte no fim da tela)
+static void write_string(const char *str, uint8_t x, uint8_t y) {
+  uint8_t spacing = font_width + 1;
+  while (*str) {
+    write_char(*str++, x, y);
+    x += spacing;
+    if (x + spacing >= WIDTH) {
+      x = 0;
+      y += font_height + 1;
+    }
+    if (y + font_height + 1 >= HEIGHT) break;
+  }
+}
+
+// Compressão RLE em pares (quantidade, valor), quantidade de 1 a 255
+static size_t rle_encode(const uint8_t *in, size_t len, uint8_t *out) {
+  size_t n = 0;
+  for (size_t i = 0; i < len;) {
+    uint8_t value = in[i];
+    size_t run = 1;
+    while (i + run < len && in[i + run] == value && run < 255) run++;
+    out[n++] = (uint8_t)run;
+    out[n++] = value;
+    i += run;
+  }
+  return n;
+}
+
+static void emit_array(const char *name, const uint8_t *data, size_t len) {
+  printf("static const uint8_t %s[%zu] = {", name, len);
+  for (size_t i = 0; i < len; i++) {
+    if (i % 16 == 0) printf("\n  ");
+    printf("0x%02X,", data[i]);
+  }
+  printf("\n};\n");
+}
+
+int main(int argc, char **argv) {
+  int x = ALERT_MSG_X, y = ALERT_MSG_Y, count = 0, rle_pct = 0;
+  const char *texts[16];
+  int xs[16], ys[16];
+  const char *output = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-o") && i + 1 < argc) output = argv[++i];
+    else if (!strcmp(argv[i], "-x") && i + 1 < argc) x = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-y") && i + 1 < argc) y = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-rle") && i + 1 < argc) rle_pct = atoi(argv[++i]);
+    else if (count < 16) {
+      texts[count] = argv[i];
+      xs[count] = x;
+      ys[count] = y;
+      count++;
+    }
+  }
+  if (count == 0) {  // Padrão: as mensagens de alerta do firmware
+    static const char *const alerts[ALERT_MSG_COUNT] = ALERT_MSG_LIST;
+    for (; count < ALERT_MSG_COUNT; count++) {
+      texts[count] = alerts[count];
+      xs[count] = ALERT_MSG_X;
+      ys[count] = ALERT_MSG_Y;
+    }
+  }
+  if (output && !freopen(output, "w", stdout)) {
+    fprintf(stderr, "oled_screens_gen: não foi possível criar %s\n", output);
+    return 1;
+  }
+
+  printf("// ARQUIVO GERADO por tools/oled_screens_gen.c durante o build - NÃO EDITAR\n");
+  printf("#include \"headers/oled_screens.h\"\n\n");
+
+  static uint8_t rle[BUFSIZE * 2];
+  bool is_rle[16];
+  for (int s = 0; s < count; s++) {
+    memset(buffer, 0, sizeof(buffer));
+    buffer[0] = 0x40; // Byte de controle de dados, igual ao ram_buffer[0] de ssd1306_init
+    write_string(texts[s], xs[s], ys[s]);
+    size_t rle_len = rle_encode(buffer + 1, BUFSIZE - 1, rle);
+    char name[32];
+    snprintf(name, sizeof(name), "SCREEN_%d", s);
+    printf("// \"%s\" em (%d,%d)\n", texts[s], xs[s], ys[s]);
+    // A imagem bruta já inclui o byte 0x40 e vai direto da flash; RLE só quando pedido e pequeno o bastante
+    is_rle[s] = rle_pct > 0 && rle_len * 100 <= (size_t)(BUFSIZE - 1) * rle_pct;
+    if (is_rle[s]) emit_array(name, rle, rle_len);
+    else emit_array(name, buffer, BUFSIZE);
+    printf("\n");
+  }
+
+  printf("const oled_screen_t OLED_SCREENS[] = {\n");
+  for (int s = 0; s < count; s++) {
+    printf("  {\"%s\", %d, %d, %s, SCREEN_%d, sizeof(SCREEN_%d)},\n",
+           texts[s], xs[s], ys[s], is_rle[s] ? "true" : "false", s, s);
+  }
+  printf("};\n");
+  printf("const size_t OLED_SCREENS_COUNT = sizeof(OLED_SCREENS) / sizeof(OLED_SCREENS[0]);\n");
+  return 0;
+}